@@ -22,3 +22,8 @@ void AccICNewtonRaphson::preRun()
 	system->logString(str);
 	AccNewtonRaphson::preRun();
 }
+
+bool AccICNewtonRaphson::usesBroydenUpdates()
+{
+	return system->useBroydenUpdatesAccIC;
+}
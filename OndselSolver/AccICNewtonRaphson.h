@@ -17,6 +17,7 @@ namespace MbD {
     public:
         bool isConverged() override;
         void preRun() override;
+        bool usesBroydenUpdates() override;
 
 
     };
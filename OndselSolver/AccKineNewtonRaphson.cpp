@@ -24,3 +24,13 @@ void AccKineNewtonRaphson::preRun()
 	system->logString(str);
 	AccNewtonRaphson::preRun();
 }
+
+bool AccKineNewtonRaphson::usesKrylovSolver()
+{
+	return system->useKrylovSolverAccKine;
+}
+
+bool AccKineNewtonRaphson::usesBroydenUpdates()
+{
+	return system->useBroydenUpdatesAccKine;
+}
@@ -17,6 +17,8 @@ namespace MbD {
     public:
         void initializeGlobally() override;
         void preRun() override;
+        bool usesKrylovSolver() override;
+        bool usesBroydenUpdates() override;
 
 
     };
@@ -124,20 +124,19 @@ void AccNewtonRaphson::preRun()
 	system->partsJointsMotionsForcesTorquesDo([&](std::shared_ptr<Item> item) { item->preAccIC(); });
 }
 
+double AccNewtonRaphson::jacobianReuseRatio()
+{
+	//"The acceleration equations are nearly linear. Broyden steps are kept while they halve or better."
+	return this->usesBroydenUpdates() ? 0.5 : 0.0;
+}
+
 void MbD::AccNewtonRaphson::handleSingularMatrix()
 {
-    auto& r = *matrixSolver;
-	std::string str = typeid(r).name();
-	if (str.find("GESpMatParPvMarkoFast") != std::string::npos) {
+	if (!matrixSolver->isPrecise()) {
 		matrixSolver = CREATE<GESpMatParPvPrecise>::With();
 		this->solveEquations();
 	} else {
-		str = typeid(r).name();
-		if (str.find("GESpMatParPvPrecise") != std::string::npos) {
-			this->logSingularMatrixMessage();
-			matrixSolver->throwSingularMatrixError("AccAccNewtonRaphson");
-		} else {
-			assert(false);
-		}
+		this->logSingularMatrixMessage();
+		matrixSolver->throwSingularMatrixError("AccAccNewtonRaphson");
 	}
 }
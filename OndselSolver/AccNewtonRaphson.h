@@ -26,6 +26,7 @@ namespace MbD {
         void postRun() override;
         void preRun() override;
         void handleSingularMatrix() override;
+        double jacobianReuseRatio() override;
 
 
     };
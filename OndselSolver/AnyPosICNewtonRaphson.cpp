@@ -29,6 +29,21 @@ void AnyPosICNewtonRaphson::initializeGlobally()
 		});
 }
 
+bool AnyPosICNewtonRaphson::usesKrylovSolver()
+{
+	return system->useKrylovSolverPosIC;
+}
+
+bool AnyPosICNewtonRaphson::usesBlockTriangularForm()
+{
+	return system->useBlockTriangularFormPosIC;
+}
+
+double AnyPosICNewtonRaphson::jacobianReuseRatio()
+{
+	return system->jacobianReuseRatioPosIC;
+}
+
 void AnyPosICNewtonRaphson::createVectorsAndMatrices()
 {
 	qsuOld = std::make_shared<FullColumn<double>>(nqsu);
@@ -42,8 +57,8 @@ void AnyPosICNewtonRaphson::fillY()
 	newMinusOld->equalSelfPlusFullColumnAt(x, 0);
 	y->zeroSelf();
 	y->atiminusFullColumn(0, (qsuWeights->timesFullColumn(newMinusOld)));
-	system->partsJointsMotionsDo([&](std::shared_ptr<Item> item) {
-		item->fillPosICError(y);
+	system->partsJointsMotionsFillColumn(y, [&](std::shared_ptr<Item> item, FColDsptr col) {
+		item->fillPosICError(col);
 		//std::cout << item->name << *y << std::endl;
 		//noop();
 		});
@@ -54,8 +69,8 @@ void AnyPosICNewtonRaphson::fillPyPx()
 {
 	pypx->zeroSelf();
 	pypx->atijminusDiagonalMatrix(0, 0, qsuWeights);
-	system->partsJointsMotionsDo([&](std::shared_ptr<Item> item) {
-		item->fillPosICJacob(pypx);
+	system->partsJointsMotionsFillMatrix(pypx, [&](std::shared_ptr<Item> item, SpMatDsptr mat) {
+		item->fillPosICJacob(mat);
 		//std::cout << *(pypx->at(3)) << std::endl;
 		});
 	//std::cout << *pypx << std::endl;
@@ -25,6 +25,9 @@ namespace MbD {
         void fillPyPx() override;
         void passRootToSystem() override;
         void assignEquationNumbers() override = 0;
+        bool usesKrylovSolver() override;
+        bool usesBlockTriangularForm() override;
+        double jacobianReuseRatio() override;
 
         int nqsu = -1;
         FColDsptr qsuOld;
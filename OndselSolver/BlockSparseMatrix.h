@@ -0,0 +1,603 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <cassert>
+
+#include "SparseMatrix.h"
+
+namespace MbD {
+	template<typename T>
+	class BlockSparseMatrix;
+	template<typename T>
+	using BSpMatsptr = std::shared_ptr<BlockSparseMatrix<T>>;
+	using BSpMatDsptr = std::shared_ptr<BlockSparseMatrix<double>>;
+
+	template<typename T>
+	class BlockSparseMatrix : public SparseMatrix<T>
+	{
+		//rowBlockStarts colBlockStarts rowBlockOf colBlockOf blockRowStarts blockColIndices blocks isCompressed hasOverflow
+		//scatterWindows scatterOffsets scatterCursor isRecordingScatter isReplayingScatter
+		//"Block compressed sparse row (BSR) storage."
+		//"Rows and columns are partitioned into blocks of at most four, normally the qX and qE of each part."
+		//"Every block is stored densely in a fixed 4x4 array so the loops over a block have constant trip counts."
+		//"This is the assembly format of the Newton Jacobians, with a cached scatter map."
+		//"There is no block elimination. The solvers read rows with rowDo into their CompressedSparseMatrix."
+		//"The map rows of SparseMatrix are the assembly-time builder and overflow."
+		//"Items fill the same windows in the same order at every iteration."
+		//"The first fill on a settled pattern records the value offsets of every window as a scatter map."
+		//"Later fills take the offsets in order and add without searching."
+		//"A window out of order stops the replay and the next zeroSelf records again."
+		//"at(i) is only the overflow of row i. Whole rows are read with rowDo."
+	public:
+		static constexpr int blockDim = 4;
+		static constexpr int blockSize = blockDim * blockDim;
+		using Block = std::array<T, blockSize>;
+		struct ScatterWindow {
+			int i, j, nrow, ncol, offset;
+		};
+
+		BlockSparseMatrix(int m, int n, const std::vector<int>& rowStarts, const std::vector<int>& colStarts);
+		static std::vector<int> blockStartsFor(int n, std::vector<std::pair<int, int>> startsAndSizes);
+		void compress();
+		Block* blockAt(int bi, int bj);
+		template<typename F>
+		void entriesDo(int i, int j, int nrow, int ncol, F f);
+		int numberOfBlocks();
+		double sumOfSquares() override;
+		void zeroSelf() override;
+		void resetScatterMap();
+		void atiput(int i, SpRowsptr<T> spRow) override;
+		void atijplusDiagonalMatrix(int i, int j, DiagMatDsptr diagMat) override;
+		void atijminusDiagonalMatrix(int i, int j, DiagMatDsptr diagMat) override;
+		void atijplusFullRow(int i, int j, FRowsptr<T> fullRow) override;
+		void atijplusFullColumn(int i, int j, FColsptr<T> fullCol) override;
+		void atijplusFullMatrix(int i, int j, FMatDsptr fullMat) override;
+		void atijminusFullMatrix(int i, int j, FMatDsptr fullMat) override;
+		void atijplusTransposeFullMatrix(int i, int j, FMatDsptr fullMat) override;
+		void atijplusFullMatrixtimes(int i, int j, FMatDsptr fullMat, T factor) override;
+		void atijminusFullColumn(int i, int j, FColDsptr fullCol) override;
+		void atijminusTransposeFullMatrix(int i, int j, FMatDsptr fullMat) override;
+		void atijplusNumber(int i, int j, double value) override;
+		void atijminusNumber(int i, int j, double value) override;
+		void atijput(int i, int j, T value) override;
+		void atijplusArray(int i, int j, int nrow, int ncol, const T* values) override;
+		double maxMagnitude() override;
+		double maxMagnitudeOfRow(int i) override;
+		void rowDo(int i, const std::function<void(int, T)>& f) override;
+		FColsptr<T> timesFullColumn(FColsptr<T> fullCol) override;
+		SpMatsptr<T> plusSparseMatrix(SpMatsptr<T> spMat) override;
+		std::shared_ptr<SparseMatrix<T>> clonesptr() override;
+		void magnifySelf(T factor) override;
+
+		static void blockTimesArrayPlus(const Block& block, const T* x, T* y);
+
+		std::ostream& printOn(std::ostream& s) const override;
+
+		std::vector<int> rowBlockStarts, colBlockStarts, rowBlockOf, colBlockOf;
+		std::vector<int> blockRowStarts, blockColIndices;
+		std::vector<Block> blocks;
+		bool isCompressed = false, hasOverflow = false;
+		std::vector<ScatterWindow> scatterWindows;
+		std::vector<int> scatterOffsets;
+		int scatterCursor = 0;
+		bool isRecordingScatter = false, isReplayingScatter = false;
+	};
+
+	template<typename T>
+	inline BlockSparseMatrix<T>::BlockSparseMatrix(int m, int n, const std::vector<int>& rowStarts, const std::vector<int>& colStarts) :
+		SparseMatrix<T>(m, n), rowBlockStarts(rowStarts), colBlockStarts(colStarts), rowBlockOf(m), colBlockOf(n)
+	{
+		//"rowStarts and colStarts hold the first index of each block followed by m and n respectively."
+		assert(rowBlockStarts.front() == 0 && rowBlockStarts.back() == m);
+		assert(colBlockStarts.front() == 0 && colBlockStarts.back() == n);
+		for (int bi = 0; bi < (int)rowBlockStarts.size() - 1; bi++)
+		{
+			assert(rowBlockStarts[bi + 1] - rowBlockStarts[bi] <= blockDim);
+			for (int i = rowBlockStarts[bi]; i < rowBlockStarts[bi + 1]; i++) rowBlockOf[i] = bi;
+		}
+		for (int bj = 0; bj < (int)colBlockStarts.size() - 1; bj++)
+		{
+			assert(colBlockStarts[bj + 1] - colBlockStarts[bj] <= blockDim);
+			for (int j = colBlockStarts[bj]; j < colBlockStarts[bj + 1]; j++) colBlockOf[j] = bj;
+		}
+		blockRowStarts.assign(rowBlockStarts.size(), 0);
+	}
+	template<typename T>
+	inline std::vector<int> BlockSparseMatrix<T>::blockStartsFor(int n, std::vector<std::pair<int, int>> startsAndSizes)
+	{
+		//"Indices not covered by a given block become blocks of one."
+		std::sort(startsAndSizes.begin(), startsAndSizes.end());
+		std::vector<int> answer;
+		int next = 0;
+		for (auto const& startAndSize : startsAndSizes)
+		{
+			auto start = startAndSize.first;
+			assert(start >= next);
+			while (next < start) answer.push_back(next++);
+			answer.push_back(start);
+			next = start + startAndSize.second;
+		}
+		while (next < n) answer.push_back(next++);
+		answer.push_back(n);
+		return answer;
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::compress()
+	{
+		//"Merge the current block pattern with the blocks touched by entries in the map rows."
+		auto nBlockRows = (int)rowBlockStarts.size() - 1;
+		std::vector<int> newBlockRowStarts(nBlockRows + 1, 0);
+		std::vector<int> newBlockColIndices;
+		std::vector<Block> newBlocks;
+		newBlockColIndices.reserve(blockColIndices.size());
+		newBlocks.reserve(blocks.size());
+		std::vector<int> rowBlockCols;
+		for (int bi = 0; bi < nBlockRows; bi++)
+		{
+			newBlockRowStarts[bi] = (int)newBlockColIndices.size();
+			rowBlockCols.assign(blockColIndices.begin() + blockRowStarts[bi], blockColIndices.begin() + blockRowStarts[bi + 1]);
+			for (int i = rowBlockStarts[bi]; i < rowBlockStarts[bi + 1]; i++)
+			{
+				for (auto const& keyValue : *(this->at(i))) rowBlockCols.push_back(colBlockOf[keyValue.first]);
+			}
+			std::sort(rowBlockCols.begin(), rowBlockCols.end());
+			rowBlockCols.erase(std::unique(rowBlockCols.begin(), rowBlockCols.end()), rowBlockCols.end());
+			auto k = blockRowStarts[bi];
+			for (auto bj : rowBlockCols)
+			{
+				newBlockColIndices.push_back(bj);
+				if (k < blockRowStarts[bi + 1] && blockColIndices[k] == bj) {
+					newBlocks.push_back(blocks[k]);
+					k++;
+				}
+				else {
+					newBlocks.emplace_back();
+					newBlocks.back().fill((T)0);
+				}
+			}
+			for (int i = rowBlockStarts[bi]; i < rowBlockStarts[bi + 1]; i++)
+			{
+				auto& spRowi = this->at(i);
+				auto ii = i - rowBlockStarts[bi];
+				for (auto const& keyValue : *spRowi)
+				{
+					auto j = keyValue.first;
+					auto bj = colBlockOf[j];
+					auto slot = newBlockRowStarts[bi] + (int)(std::lower_bound(rowBlockCols.begin(), rowBlockCols.end(), bj) - rowBlockCols.begin());
+					newBlocks[slot][ii * blockDim + j - colBlockStarts[bj]] += keyValue.second;
+				}
+				spRowi->clear();
+			}
+		}
+		newBlockRowStarts[nBlockRows] = (int)newBlockColIndices.size();
+		blockRowStarts.swap(newBlockRowStarts);
+		blockColIndices.swap(newBlockColIndices);
+		blocks.swap(newBlocks);
+		isCompressed = true;
+		hasOverflow = false;
+	}
+	template<typename T>
+	inline typename BlockSparseMatrix<T>::Block* BlockSparseMatrix<T>::blockAt(int bi, int bj)
+	{
+		//"Answer nullptr when block (bi, bj) is not in the pattern."
+		auto begin = blockColIndices.begin() + blockRowStarts[bi];
+		auto end = blockColIndices.begin() + blockRowStarts[bi + 1];
+		auto itr = std::lower_bound(begin, end, bj);
+		if (itr == end || *itr != bj) return nullptr;
+		return &blocks[itr - blockColIndices.begin()];
+	}
+	template<typename T>
+	template<typename F>
+	inline void BlockSparseMatrix<T>::entriesDo(int i, int j, int nrow, int ncol, F f)
+	{
+		//"Call f(entry, ii, jj) for every entry (i + ii, j + jj) of the nrow x ncol window."
+		//"The window is cut along block boundaries and each block is looked up once."
+		if (isReplayingScatter) {
+			auto window = scatterCursor < (int)scatterWindows.size() ? &scatterWindows[scatterCursor] : nullptr;
+			if (window && window->i == i && window->j == j && window->nrow == nrow && window->ncol == ncol) {
+				scatterCursor++;
+				auto offsets = scatterOffsets.data() + window->offset;
+				for (int ii = 0; ii < nrow; ii++)
+				{
+					for (int jj = 0; jj < ncol; jj++)
+					{
+						auto offset = *offsets++;
+						f(blocks[offset / blockSize][offset % blockSize], ii, jj);
+					}
+				}
+				return;
+			}
+			this->resetScatterMap();
+		}
+		if (isRecordingScatter) {
+			auto offset = (int)scatterOffsets.size();
+			scatterWindows.push_back({ i, j, nrow, ncol, offset });
+			scatterOffsets.resize(offset + nrow * ncol, -1);
+		}
+		auto iend = i + nrow;
+		auto jend = j + ncol;
+		auto i0 = i;
+		while (i0 < iend) {
+			auto bi = rowBlockOf[i0];
+			auto rs = rowBlockStarts[bi];
+			auto i1 = std::min(rowBlockStarts[bi + 1], iend);
+			auto j0 = j;
+			while (j0 < jend) {
+				auto bj = colBlockOf[j0];
+				auto cs = colBlockStarts[bj];
+				auto j1 = std::min(colBlockStarts[bj + 1], jend);
+				auto block = isCompressed ? this->blockAt(bi, bj) : nullptr;
+				if (block) {
+					for (int r = i0; r < i1; r++)
+					{
+						auto* blockRow = block->data() + (r - rs) * blockDim;
+						for (int c = j0; c < j1; c++)
+						{
+							if (isRecordingScatter) {
+								auto offset = (int)(block - blocks.data()) * blockSize + (r - rs) * blockDim + c - cs;
+								scatterOffsets[scatterWindows.back().offset + (r - i) * ncol + c - j] = offset;
+							}
+							f(blockRow[c - cs], r - i, c - j);
+						}
+					}
+				}
+				else {
+					if (isCompressed) hasOverflow = true;
+					isRecordingScatter = false;
+					for (int r = i0; r < i1; r++)
+					{
+						auto& spRow = *(this->at(r));
+						for (int c = j0; c < j1; c++)
+						{
+							f(spRow[c], r - i, c - j);
+						}
+					}
+				}
+				j0 = j1;
+			}
+			i0 = i1;
+		}
+	}
+	template<typename T>
+	inline int BlockSparseMatrix<T>::numberOfBlocks()
+	{
+		return (int)blocks.size();
+	}
+	template<>
+	inline double BlockSparseMatrix<double>::sumOfSquares()
+	{
+		//"blocks is one contiguous array of doubles."
+		static_assert(sizeof(Block) == blockSize * sizeof(double));
+		double sum = SparseMatrix<double>::sumOfSquares();
+		if (blocks.empty()) return sum;
+		return sum + VectorKernels::sumOfSquares(blocks.data()->data(), (int)blocks.size() * blockSize);
+	}
+	template<typename T>
+	inline double BlockSparseMatrix<T>::sumOfSquares()
+	{
+		double sum = SparseMatrix<T>::sumOfSquares();
+		for (auto const& block : blocks)
+		{
+			for (auto const& value : block)
+			{
+				sum += value * value;
+			}
+		}
+		return sum;
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::zeroSelf()
+	{
+		//"Overflow stops recording, so compress never moves blocks under a scatter map."
+		//"A finished recording is replayed from now on. Otherwise recording starts afresh."
+		if (!isCompressed || hasOverflow) this->compress();
+		if (isRecordingScatter) {
+			isRecordingScatter = false;
+			isReplayingScatter = true;
+		}
+		else if (!isReplayingScatter) {
+			this->resetScatterMap();
+			isRecordingScatter = !blocks.empty();
+		}
+		scatterCursor = 0;
+		for (auto& block : blocks)
+		{
+			block.fill((T)0);
+		}
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::resetScatterMap()
+	{
+		//"Forget the scatter map. The next zeroSelf starts a new recording."
+		scatterWindows.clear();
+		scatterOffsets.clear();
+		scatterCursor = 0;
+		isReplayingScatter = false;
+		isRecordingScatter = false;
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::atiput(int i, SpRowsptr<T> spRow)
+	{
+		//"Row i becomes spRow. Its block entries are zeroed and spRow is its overflow until the next compress."
+		auto bi = rowBlockOf[i];
+		auto offset = (i - rowBlockStarts[bi]) * blockDim;
+		for (int k = blockRowStarts[bi]; k < blockRowStarts[bi + 1]; k++)
+		{
+			std::fill(blocks[k].begin() + offset, blocks[k].begin() + offset + blockDim, (T)0);
+		}
+		this->at(i) = spRow;
+		if (isCompressed) hasOverflow = true;
+		this->resetScatterMap();
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::atijplusDiagonalMatrix(int i, int j, DiagMatDsptr diagMat)
+	{
+		auto n = diagMat->nrow();
+		for (int ii = 0; ii < n; ii++)
+		{
+			this->entriesDo(i + ii, j + ii, 1, 1, [&](T& entry, int, int) { entry += diagMat->at(ii); });
+		}
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::atijminusDiagonalMatrix(int i, int j, DiagMatDsptr diagMat)
+	{
+		auto n = diagMat->nrow();
+		for (int ii = 0; ii < n; ii++)
+		{
+			this->entriesDo(i + ii, j + ii, 1, 1, [&](T& entry, int, int) { entry -= diagMat->at(ii); });
+		}
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::atijplusFullRow(int i, int j, FRowsptr<T> fullRow)
+	{
+		this->entriesDo(i, j, 1, (int)fullRow->size(), [&](T& entry, int, int jj) {
+			entry += fullRow->at(jj);
+			});
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::atijplusFullColumn(int i, int j, FColsptr<T> fullCol)
+	{
+		this->entriesDo(i, j, (int)fullCol->size(), 1, [&](T& entry, int ii, int) {
+			entry += fullCol->at(ii);
+			});
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::atijplusFullMatrix(int i, int j, FMatDsptr fullMat)
+	{
+		this->entriesDo(i, j, fullMat->nrow(), fullMat->ncol(), [&](T& entry, int ii, int jj) {
+			entry += fullMat->at(ii)->at(jj);
+			});
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::atijminusFullMatrix(int i, int j, FMatDsptr fullMat)
+	{
+		this->entriesDo(i, j, fullMat->nrow(), fullMat->ncol(), [&](T& entry, int ii, int jj) {
+			entry -= fullMat->at(ii)->at(jj);
+			});
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::atijplusTransposeFullMatrix(int i, int j, FMatDsptr fullMat)
+	{
+		//"No transposed copy is made."
+		this->entriesDo(i, j, fullMat->ncol(), fullMat->nrow(), [&](T& entry, int ii, int jj) {
+			entry += fullMat->at(jj)->at(ii);
+			});
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::atijplusFullMatrixtimes(int i, int j, FMatDsptr fullMat, T factor)
+	{
+		this->entriesDo(i, j, fullMat->nrow(), fullMat->ncol(), [&](T& entry, int ii, int jj) {
+			entry += fullMat->at(ii)->at(jj) * factor;
+			});
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::atijminusFullColumn(int i, int j, FColDsptr fullCol)
+	{
+		this->entriesDo(i, j, (int)fullCol->size(), 1, [&](T& entry, int ii, int) {
+			entry -= fullCol->at(ii);
+			});
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::atijminusTransposeFullMatrix(int i, int j, FMatDsptr fullMat)
+	{
+		this->entriesDo(i, j, fullMat->ncol(), fullMat->nrow(), [&](T& entry, int ii, int jj) {
+			entry -= fullMat->at(jj)->at(ii);
+			});
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::atijplusNumber(int i, int j, double value)
+	{
+		this->entriesDo(i, j, 1, 1, [&](T& entry, int, int) { entry += value; });
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::atijminusNumber(int i, int j, double value)
+	{
+		this->entriesDo(i, j, 1, 1, [&](T& entry, int, int) { entry -= value; });
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::atijput(int i, int j, T value)
+	{
+		this->entriesDo(i, j, 1, 1, [&](T& entry, int, int) { entry = value; });
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::atijplusArray(int i, int j, int nrow, int ncol, const T* values)
+	{
+		this->entriesDo(i, j, nrow, ncol, [&](T& entry, int ii, int jj) {
+			entry += values[ii * ncol + jj];
+			});
+	}
+	template<>
+	inline double BlockSparseMatrix<double>::maxMagnitude()
+	{
+		double max = SparseMatrix<double>::maxMagnitude();
+		if (blocks.empty()) return max;
+		double blockMax = VectorKernels::maxMagnitude(blocks.data()->data(), (int)blocks.size() * blockSize);
+		return max < blockMax ? blockMax : max;
+	}
+	template<typename T>
+	inline double BlockSparseMatrix<T>::maxMagnitude()
+	{
+		double max = SparseMatrix<T>::maxMagnitude();
+		for (auto const& block : blocks)
+		{
+			for (auto const& value : block)
+			{
+				auto mag = value;
+				if (mag < 0.0) mag = -mag;
+				if (max < mag) max = mag;
+			}
+		}
+		return max;
+	}
+	template<typename T>
+	inline double BlockSparseMatrix<T>::maxMagnitudeOfRow(int i)
+	{
+		//"Padding entries are zero so whole block rows can be scanned."
+		double max = this->at(i)->maxMagnitude();
+		auto bi = rowBlockOf[i];
+		auto offset = (i - rowBlockStarts[bi]) * blockDim;
+		for (int k = blockRowStarts[bi]; k < blockRowStarts[bi + 1]; k++)
+		{
+			for (int jj = 0; jj < blockDim; jj++)
+			{
+				auto mag = blocks[k][offset + jj];
+				if (mag < 0.0) mag = -mag;
+				if (max < mag) max = mag;
+			}
+		}
+		return max;
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::rowDo(int i, const std::function<void(int, T)>& f)
+	{
+		auto bi = rowBlockOf[i];
+		auto offset = (i - rowBlockStarts[bi]) * blockDim;
+		for (int k = blockRowStarts[bi]; k < blockRowStarts[bi + 1]; k++)
+		{
+			auto bj = blockColIndices[k];
+			auto cs = colBlockStarts[bj];
+			auto width = colBlockStarts[bj + 1] - cs;
+			for (int jj = 0; jj < width; jj++)
+			{
+				f(cs + jj, blocks[k][offset + jj]);
+			}
+		}
+		SparseMatrix<T>::rowDo(i, f);
+	}
+	template<typename T>
+	inline FColsptr<T> BlockSparseMatrix<T>::timesFullColumn(FColsptr<T> fullCol)
+	{
+		//"a*b = a(i,j)b(j) sum j."
+		//"Block products use padded copies of the column and answer segments."
+		auto nrow = this->nrow();
+		auto answer = std::make_shared<FullColumn<T>>(nrow);
+		auto nBlockRows = (int)rowBlockStarts.size() - 1;
+		for (int bi = 0; bi < nBlockRows; bi++)
+		{
+			T y[blockDim] = {};
+			for (int k = blockRowStarts[bi]; k < blockRowStarts[bi + 1]; k++)
+			{
+				auto bj = blockColIndices[k];
+				auto cs = colBlockStarts[bj];
+				auto width = colBlockStarts[bj + 1] - cs;
+				T x[blockDim] = {};
+				for (int jj = 0; jj < width; jj++) x[jj] = fullCol->at(cs + jj);
+				blockTimesArrayPlus(blocks[k], x, y);
+			}
+			for (int i = rowBlockStarts[bi]; i < rowBlockStarts[bi + 1]; i++)
+			{
+				answer->at(i) = y[i - rowBlockStarts[bi]] + this->at(i)->timesFullColumn(fullCol);
+			}
+		}
+		return answer;
+	}
+	template<typename T>
+	inline SpMatsptr<T> BlockSparseMatrix<T>::plusSparseMatrix(SpMatsptr<T> spMat)
+	{
+		//"a + b with the blocks of a. spMat is read with rowDo."
+		auto answer = this->clonesptr();
+		for (int i = 0; i < answer->nrow(); i++)
+		{
+			spMat->rowDo(i, [&](int j, T value) { answer->atijplusNumber(i, j, value); });
+		}
+		return answer;
+	}
+	template<typename T>
+	inline std::shared_ptr<SparseMatrix<T>> BlockSparseMatrix<T>::clonesptr()
+	{
+		//"Blocks and overflow rows are copied. The clone records its own scatter map."
+		auto answer = std::make_shared<BlockSparseMatrix<T>>(*this);
+		for (auto& row : *answer) row = row->clonesptr();
+		answer->resetScatterMap();
+		return answer;
+	}
+	template<>
+	inline void BlockSparseMatrix<double>::magnifySelf(double factor)
+	{
+		SparseMatrix<double>::magnifySelf(factor);
+		if (blocks.empty()) return;
+		VectorKernels::times(blocks.data()->data(), factor, (int)blocks.size() * blockSize);
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::magnifySelf(T factor)
+	{
+		SparseMatrix<T>::magnifySelf(factor);
+		for (auto& block : blocks)
+		{
+			for (auto& value : block)
+			{
+				value *= factor;
+			}
+		}
+	}
+	template<typename T>
+	inline void BlockSparseMatrix<T>::blockTimesArrayPlus(const Block& block, const T* x, T* y)
+	{
+		//"y := y + block*x for padded four element arrays."
+		for (int r = 0; r < blockDim; r++)
+		{
+			T sum = 0;
+			for (int c = 0; c < blockDim; c++)
+			{
+				sum += block[r * blockDim + c] * x[c];
+			}
+			y[r] += sum;
+		}
+	}
+	template<typename T>
+	inline std::ostream& BlockSparseMatrix<T>::printOn(std::ostream& s) const
+	{
+		s << "BSpMat[" << std::endl;
+		auto nBlockRows = (int)rowBlockStarts.size() - 1;
+		for (int bi = 0; bi < nBlockRows; bi++)
+		{
+			for (int i = rowBlockStarts[bi]; i < rowBlockStarts[bi + 1]; i++)
+			{
+				auto offset = (i - rowBlockStarts[bi]) * blockDim;
+				s << "{";
+				for (int k = blockRowStarts[bi]; k < blockRowStarts[bi + 1]; k++)
+				{
+					auto bj = blockColIndices[k];
+					for (int j = colBlockStarts[bj]; j < colBlockStarts[bj + 1]; j++)
+					{
+						if (k > blockRowStarts[bi] || j > colBlockStarts[bj]) s << ", ";
+						s << j << "->" << blocks[k][offset + j - colBlockStarts[bj]];
+					}
+				}
+				s << "} " << *(this->at(i)) << std::endl;
+			}
+		}
+		s << "]" << std::endl;
+		return s;
+	}
+}
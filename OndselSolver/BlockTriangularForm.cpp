@@ -0,0 +1,182 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <cassert>
+
+#include "BlockTriangularForm.h"
+
+using namespace MbD;
+
+void BlockTriangularForm::analyze(SpMatDsptr spMat)
+{
+	//"Transversal by depth first augmenting paths with a cheap assignment first (Duff's MC21)."
+	//"Strong components by Tarjan. Both are iterative because chains of parts make long paths."
+	n = spMat->ncol();
+	assert(spMat->nrow() == n);
+	std::vector<int> rowStarts(n + 1, 0), rowCols;
+	for (int i = 0; i < n; i++)
+	{
+		spMat->rowDo(i, [&](int j, double) { rowCols.push_back(j); });
+		rowStarts[i + 1] = (int)rowCols.size();
+	}
+	std::vector<int> rowOfCol(n, -1), colOfRow(n, -1), visits(n, -1), pathRows, pathNexts, pathCols;
+	isStructurallySingular = false;
+	for (int i0 = 0; i0 < n; i0++)
+	{
+		for (int kk = rowStarts[i0]; kk < rowStarts[i0 + 1]; kk++)
+		{
+			auto j = rowCols[kk];
+			if (rowOfCol[j] < 0) {
+				rowOfCol[j] = i0;
+				colOfRow[i0] = j;
+				break;
+			}
+		}
+		if (colOfRow[i0] >= 0) continue;
+		pathRows.assign(1, i0);
+		pathNexts.assign(1, rowStarts[i0]);
+		pathCols.assign(1, -1);
+		auto freeCol = -1;
+		while (!pathRows.empty() && freeCol < 0) {
+			auto level = (int)pathRows.size() - 1;
+			auto i = pathRows[level];
+			if (pathNexts[level] == rowStarts[i + 1]) {
+				pathRows.pop_back();
+				pathNexts.pop_back();
+				pathCols.pop_back();
+				continue;
+			}
+			auto j = rowCols[pathNexts[level]++];
+			if (visits[j] == i0) continue;
+			visits[j] = i0;
+			pathCols[level] = j;
+			if (rowOfCol[j] < 0) {
+				freeCol = j;
+			}
+			else {
+				pathRows.push_back(rowOfCol[j]);
+				pathNexts.push_back(rowStarts[rowOfCol[j]]);
+				pathCols.push_back(-1);
+			}
+		}
+		if (freeCol < 0) {
+			isStructurallySingular = true;
+			break;
+		}
+		for (int level = 0; level < (int)pathRows.size(); level++)
+		{
+			rowOfCol[pathCols[level]] = pathRows[level];
+			colOfRow[pathRows[level]] = pathCols[level];
+		}
+	}
+	rowOrder.clear();
+	colOrder.clear();
+	blockStarts.assign(1, 0);
+	if (!isStructurallySingular) {
+		std::vector<int> indices(n, -1), lowLinks(n, 0), stack, callCols, callNexts;
+		std::vector<bool> isOnStack(n, false);
+		int index = 0;
+		for (int j0 = 0; j0 < n; j0++)
+		{
+			if (indices[j0] >= 0) continue;
+			auto visit = [&](int j) {
+				indices[j] = index;
+				lowLinks[j] = index;
+				index++;
+				stack.push_back(j);
+				isOnStack[j] = true;
+				callCols.push_back(j);
+				callNexts.push_back(rowStarts[rowOfCol[j]]);
+				};
+			visit(j0);
+			while (!callCols.empty()) {
+				auto j = callCols.back();
+				auto& next = callNexts.back();
+				if (next < rowStarts[rowOfCol[j] + 1]) {
+					auto k = rowCols[next++];
+					if (indices[k] < 0) {
+						visit(k);
+					}
+					else if (isOnStack[k]) {
+						lowLinks[j] = std::min(lowLinks[j], indices[k]);
+					}
+					continue;
+				}
+				callCols.pop_back();
+				callNexts.pop_back();
+				if (!callCols.empty()) lowLinks[callCols.back()] = std::min(lowLinks[callCols.back()], lowLinks[j]);
+				if (lowLinks[j] != indices[j]) continue;
+				auto k = -1;
+				while (k != j) {
+					k = stack.back();
+					stack.pop_back();
+					isOnStack[k] = false;
+					colOrder.push_back(k);
+					rowOrder.push_back(rowOfCol[k]);
+				}
+				blockStarts.push_back((int)colOrder.size());
+			}
+		}
+	}
+	auto nBlock = this->numberOfBlocks();
+	blockOfRow.assign(n, -1);
+	blockOfCol.assign(n, -1);
+	colPositions.assign(n, -1);
+	for (int b = 0; b < nBlock; b++)
+	{
+		for (int k = blockStarts[b]; k < blockStarts[b + 1]; k++)
+		{
+			blockOfRow[rowOrder[k]] = b;
+			blockOfCol[colOrder[k]] = b;
+			colPositions[colOrder[k]] = k;
+		}
+	}
+	blockSymbolicFactorizations.assign(nBlock, nullptr);
+	blockFillReducingOrderings.assign(nBlock, nullptr);
+	reported = false;
+	nAnalysis++;
+}
+
+bool BlockTriangularForm::isValidFor(SpMatDsptr spMat)
+{
+	return n > 0 && n == spMat->nrow() && n == spMat->ncol();
+}
+
+void BlockTriangularForm::invalidate()
+{
+	n = -1;
+}
+
+int BlockTriangularForm::numberOfBlocks()
+{
+	return (int)blockStarts.size() - 1;
+}
+
+int BlockTriangularForm::largestBlockSize()
+{
+	int answer = 0;
+	for (int b = 0; b < this->numberOfBlocks(); b++)
+	{
+		answer = std::max(answer, blockStarts[b + 1] - blockStarts[b]);
+	}
+	return answer;
+}
+
+std::string BlockTriangularForm::blockReport()
+{
+	reported = true;
+	if (isStructurallySingular) return std::string("MbD: Block triangular form not found. The pattern is structurally singular.");
+	std::string str("MbD: Block triangular form blocks = ");
+	str += std::to_string(this->numberOfBlocks());
+	str += ", largest = ";
+	str += std::to_string(this->largestBlockSize());
+	str += " of ";
+	str += std::to_string(n);
+	return str;
+}
@@ -0,0 +1,47 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "SparseMatrix.h"
+#include "SymbolicFactorization.h"
+#include "FillReducingOrdering.h"
+
+namespace MbD {
+    class BlockTriangularForm
+    {
+        //n rowOrder colOrder blockStarts blockOfRow blockOfCol colPositions isStructurallySingular
+        //blockSymbolicFactorizations blockFillReducingOrderings nAnalysis reported
+        //"Fine Dulmage-Mendelsohn decomposition of a square pattern into block lower triangular form."
+        //"A maximum transversal matches every row to a column. The strong components of the graph"
+        //"from the column of each row to the other columns of that row are the diagonal blocks."
+        //"Tarjan finds a component after all it depends on, so blocks are solved in the order found."
+        //"Block b has rows rowOrder and columns colOrder from blockStarts[b] to blockStarts[b + 1]."
+        //"Column j is at colPositions[j] in colOrder. Stored entries count, whatever their values."
+        //"Large blocks keep their own pivot sequence and column pre-ordering for sparse elimination."
+    public:
+        void analyze(SpMatDsptr spMat);
+        bool isValidFor(SpMatDsptr spMat);
+        void invalidate();
+        int numberOfBlocks();
+        int largestBlockSize();
+        std::string blockReport();
+
+        int n = -1;
+        std::vector<int> rowOrder, colOrder, blockStarts, blockOfRow, blockOfCol, colPositions;
+        bool isStructurallySingular = false;
+        std::vector<std::shared_ptr<SymbolicFactorization>> blockSymbolicFactorizations;
+        std::vector<std::shared_ptr<FillReducingOrdering>> blockFillReducingOrderings;
+        int nAnalysis = 0;
+        bool reported = true;
+    };
+}
+
@@ -0,0 +1,255 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cassert>
+
+#include "SparseMatrix.h"
+
+namespace MbD {
+	template<typename T>
+	class CompressedSparseMatrix;
+	template<typename T>
+	using CSpMatsptr = std::shared_ptr<CompressedSparseMatrix<T>>;
+	using CSpMatDsptr = std::shared_ptr<CompressedSparseMatrix<double>>;
+
+	template<typename T>
+	class CompressedSparseMatrix
+	{
+		//m n rowStarts rowLengths rowCapacities colIndices values mergeCols mergeValues
+		//"Compressed sparse row (CSR) working matrix of the sparse Gauss elimination and LDU solvers."
+		//"Row i is the run of colIndices and values from rowStarts[i] of length rowLengths[i], sorted by column."
+		//"atiputConditionedRowOf is the assembly-time builder. It appends rows from a SparseMatrix."
+		//"Swapping rows swaps their runs, not their entries."
+		//"A row that fills in beyond rowCapacities moves to the end of the arrays with room to grow, as in MA28."
+		//"The arrays keep their capacity from solve to solve, so a settled pattern allocates nothing."
+	public:
+		CompressedSparseMatrix(int m, int n);
+		int nrow() const;
+		int ncol() const;
+		void beginAssembly();
+		void atiputConditionedRowOf(int i, SpMatsptr<T> spMat, T scaling, T tol);
+		int rowBegin(int i) const;
+		int rowEnd(int i) const;
+		int rowSize(int i) const;
+		int slotAtij(int i, int j) const;
+		T atij(int i, int j) const;
+		double maxMagnitudeOfRow(int i) const;
+		int numberOfNonZeros() const;
+		void swapElems(int i, int k);
+		void permuteColumns(const std::vector<int>& colPositions);
+		template<typename F>
+		void eliminateWithPivotRow(int i, int p, int jp, T factor, F fillDo);
+		void atiputMerged(int i);
+
+		int m, n;
+		std::vector<int> rowStarts, rowLengths, rowCapacities, colIndices;
+		std::vector<T> values;
+		std::vector<int> mergeCols;
+		std::vector<T> mergeValues;
+	};
+
+	template<typename T>
+	inline CompressedSparseMatrix<T>::CompressedSparseMatrix(int m, int n) :
+		m(m), n(n), rowStarts(m, 0), rowLengths(m, 0), rowCapacities(m, 0)
+	{
+	}
+	template<typename T>
+	inline int CompressedSparseMatrix<T>::nrow() const
+	{
+		return m;
+	}
+	template<typename T>
+	inline int CompressedSparseMatrix<T>::ncol() const
+	{
+		return n;
+	}
+	template<typename T>
+	inline void CompressedSparseMatrix<T>::beginAssembly()
+	{
+		//"Rows must then be put in order 0 to m - 1."
+		colIndices.clear();
+		values.clear();
+	}
+	template<typename T>
+	inline void CompressedSparseMatrix<T>::atiputConditionedRowOf(int i, SpMatsptr<T> spMat, T scaling, T tol)
+	{
+		//"Append row i of spMat times scaling without the entries smaller than tol."
+		//"Rows of a BlockSparseMatrix come block by block and then from the overflow, so the run may need sorting."
+		auto start = (int)colIndices.size();
+		auto sorted = true;
+		spMat->rowDo(i, [&](int j, T aij) {
+			auto val = aij * scaling;
+			if (std::abs(val) < tol) return;
+			if ((int)colIndices.size() > start && colIndices.back() > j) sorted = false;
+			colIndices.push_back(j);
+			values.push_back(val);
+			});
+		rowStarts[i] = start;
+		rowLengths[i] = (int)colIndices.size() - start;
+		rowCapacities[i] = rowLengths[i];
+		if (sorted) return;
+		for (int k = start + 1; k < (int)colIndices.size(); k++)
+		{
+			auto j = colIndices[k];
+			auto val = values[k];
+			auto kk = k;
+			for (; kk > start && colIndices[kk - 1] > j; kk--)
+			{
+				colIndices[kk] = colIndices[kk - 1];
+				values[kk] = values[kk - 1];
+			}
+			colIndices[kk] = j;
+			values[kk] = val;
+		}
+	}
+	template<typename T>
+	inline int CompressedSparseMatrix<T>::rowBegin(int i) const
+	{
+		return rowStarts[i];
+	}
+	template<typename T>
+	inline int CompressedSparseMatrix<T>::rowEnd(int i) const
+	{
+		return rowStarts[i] + rowLengths[i];
+	}
+	template<typename T>
+	inline int CompressedSparseMatrix<T>::rowSize(int i) const
+	{
+		return rowLengths[i];
+	}
+	template<typename T>
+	inline int CompressedSparseMatrix<T>::slotAtij(int i, int j) const
+	{
+		//"Position of aij in colIndices and values, or -1 when aij is not stored."
+		auto first = colIndices.begin() + rowBegin(i);
+		auto last = colIndices.begin() + rowEnd(i);
+		auto itr = std::lower_bound(first, last, j);
+		if (itr == last || *itr != j) return -1;
+		return (int)(itr - colIndices.begin());
+	}
+	template<typename T>
+	inline T CompressedSparseMatrix<T>::atij(int i, int j) const
+	{
+		auto k = slotAtij(i, j);
+		assert(k >= 0);
+		return values[k];
+	}
+	template<typename T>
+	inline double CompressedSparseMatrix<T>::maxMagnitudeOfRow(int i) const
+	{
+		double max = 0.0;
+		for (int k = rowBegin(i); k < rowEnd(i); k++)
+		{
+			auto mag = values[k];
+			if (mag < 0.0) mag = -mag;
+			if (max < mag) max = mag;
+		}
+		return max;
+	}
+	template<typename T>
+	inline int CompressedSparseMatrix<T>::numberOfNonZeros() const
+	{
+		int answer = 0;
+		for (auto length : rowLengths) answer += length;
+		return answer;
+	}
+	template<typename T>
+	inline void CompressedSparseMatrix<T>::swapElems(int i, int k)
+	{
+		std::swap(rowStarts[i], rowStarts[k]);
+		std::swap(rowLengths[i], rowLengths[k]);
+		std::swap(rowCapacities[i], rowCapacities[k]);
+	}
+	template<typename T>
+	inline void CompressedSparseMatrix<T>::permuteColumns(const std::vector<int>& colPositions)
+	{
+		//"Column j moves to colPositions[j]. Each run is sorted again in place."
+		for (int i = 0; i < m; i++)
+		{
+			auto start = rowBegin(i);
+			auto end = rowEnd(i);
+			for (int k = start; k < end; k++)
+			{
+				auto j = colPositions[colIndices[k]];
+				auto val = values[k];
+				auto kk = k;
+				for (; kk > start && colIndices[kk - 1] > j; kk--)
+				{
+					colIndices[kk] = colIndices[kk - 1];
+					values[kk] = values[kk - 1];
+				}
+				colIndices[kk] = j;
+				values[kk] = val;
+			}
+		}
+	}
+	template<typename T>
+	template<typename F>
+	inline void CompressedSparseMatrix<T>::eliminateWithPivotRow(int i, int p, int jp, T factor, F fillDo)
+	{
+		//"row i := row i - (factor * row p) with column jp removed from row i."
+		//"Both runs are merged in column order. fillDo(j) is called for every new entry of row i."
+		//"A new entry is 0 - (factor * apj) as when it is added to a map row."
+		mergeCols.clear();
+		mergeValues.clear();
+		auto ki = rowBegin(i);
+		auto iend = rowEnd(i);
+		auto kp = rowBegin(p);
+		auto pend = rowEnd(p);
+		while (ki < iend || kp < pend) {
+			auto ji = ki < iend ? colIndices[ki] : INT_MAX;
+			auto jj = kp < pend ? colIndices[kp] : INT_MAX;
+			if (ji < jj) {
+				if (ji != jp) {
+					mergeCols.push_back(ji);
+					mergeValues.push_back(values[ki]);
+				}
+				ki++;
+			}
+			else if (jj < ji) {
+				if (jj != jp) {
+					mergeCols.push_back(jj);
+					mergeValues.push_back((T)0 - factor * values[kp]);
+					fillDo(jj);
+				}
+				kp++;
+			}
+			else {
+				if (jj != jp) {
+					mergeCols.push_back(jj);
+					mergeValues.push_back(values[ki] - factor * values[kp]);
+				}
+				ki++;
+				kp++;
+			}
+		}
+		this->atiputMerged(i);
+	}
+	template<typename T>
+	inline void CompressedSparseMatrix<T>::atiputMerged(int i)
+	{
+		//"Row i becomes the merge buffer, moving to the end of the arrays when it does not fit."
+		auto length = (int)mergeCols.size();
+		if (length > rowCapacities[i]) {
+			auto capacity = 2 * length;
+			rowStarts[i] = (int)colIndices.size();
+			rowCapacities[i] = capacity;
+			colIndices.resize(colIndices.size() + capacity);
+			values.resize(values.size() + capacity);
+		}
+		std::copy(mergeCols.begin(), mergeCols.end(), colIndices.begin() + rowStarts[i]);
+		std::copy(mergeValues.begin(), mergeValues.end(), values.begin() + rowStarts[i]);
+		rowLengths[i] = length;
+	}
+}
@@ -9,6 +9,7 @@
 #include "ConstantGravity.h"
 #include "System.h"
 #include "Part.h"
+#include "CREATE.h"
 
 using namespace MbD;
 
@@ -18,3 +19,11 @@ void MbD::ConstantGravity::fillAccICIterError(FColDsptr col)
 		col->atiplusFullColumntimes(part->iqX(), gXYZ, part->m);
 	}
 }
+
+std::shared_ptr<ForceTorqueItem> MbD::ConstantGravity::newCopy()
+{
+	//"Gravity acts on all parts of root, so each component gets its own."
+	auto copy = CREATE<ConstantGravity>::With();
+	copy->gXYZ = gXYZ;
+	return copy;
+}
@@ -16,6 +16,7 @@ namespace MbD {
         //
     public:
         void fillAccICIterError(FColDsptr col) override;
+        std::shared_ptr<ForceTorqueItem> newCopy() override;
 
         FColDsptr gXYZ;
     };
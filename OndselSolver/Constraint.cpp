@@ -10,6 +10,7 @@
 #include <chrono>
 
 #include "Constraint.h"
+#include "System.h"
 #include "FullColumn.h"
 #include "enum.h"
 
@@ -40,6 +41,7 @@ void Constraint::postInput()
 void Constraint::prePosIC()
 {
 	lam = 0.0;
+	hasChangedLam = true;
 	iG = -1;
 	Item::prePosIC();
 }
@@ -95,7 +97,9 @@ void Constraint::fillqsulam(FColDsptr col)
 
 void Constraint::setqsulam(FColDsptr col)
 {
-	lam = col->at(iG);
+	auto lamNew = col->at(iG);
+	if (lamNew != lam) hasChangedLam = true;
+	lam = lamNew;
 }
 
 void Constraint::setqsudotlam(FColDsptr col)
@@ -130,6 +134,19 @@ bool Constraint::isRedundant()
 	return false;
 }
 
+bool Constraint::needsSecondDerivatives()
+{
+	//"PosKine, VelIC and VelKine use only first derivatives."
+	//"PosIC uses second derivatives times lam, so none are needed while lam is zero."
+	//"AccIC and AccKine use them times qdot."
+	if (owner == nullptr) return true;
+	switch (this->root()->derivativeDemand) {
+	case FIRSTDERIVATIVES: return false;
+	case LAMWEIGHTEDSECONDDERIVATIVES: return lam != 0.0;
+	default: return true;
+	}
+}
+
 void Constraint::preDyn()
 {
 	mu = 0.0;
@@ -35,6 +35,7 @@ namespace MbD {
 		void fillqsulam(FColDsptr col) override;
 		virtual void fillRedundantConstraints(std::shared_ptr<Constraint> sptr, std::shared_ptr<std::vector<std::shared_ptr<Constraint>>> redunConstraints);
 		virtual bool isRedundant();
+		bool needsSecondDerivatives() override;
 		void postInput() override;
 		void preAccIC() override;
 		void preDyn() override;
@@ -52,6 +53,7 @@ namespace MbD {
 		double aG = 0.0;		//Constraint function
 		double aConstant = 0.0;
 		double lam = 0.0;		//Lambda is Lagrange Multiplier
+		bool hasChangedLam = true;	//lam set to a new value since the joint last updated the constraint.
 		double mu = 0.0, lamDeriv = 0.0;
 	};
 }
@@ -22,6 +22,7 @@ void DirectionCosineConstraintIJ::initialize()
 {
 	ConstraintIJ::initialize();
 	initaAijIeJe();
+	aAijIeJe->owner = this;
 }
 
 void DirectionCosineConstraintIJ::initializeLocally()
@@ -10,6 +10,7 @@
 
 #include "DirectionCosineIecJec.h"
 #include "EndFramec.h"
+#include "FixedMatrix.h"
 
 namespace MbD {
     DirectionCosineIecJec::DirectionCosineIecJec()
@@ -21,11 +22,20 @@ namespace MbD {
 
     }
 
+    void DirectionCosineIecJec::initialize()
+    {
+        KinematicIeJe::initialize();
+        aAjOIe = std::make_shared<FullColumn<double>>(3);
+        aAjOJe = std::make_shared<FullColumn<double>>(3);
+    }
+
     void DirectionCosineIecJec::calcPostDynCorrectorIteration()
     {
-        aAjOIe = frmI->aAjOe(axisI);
-        aAjOJe = frmJ->aAjOe(axisJ);
-        aAijIeJe = aAjOIe->dot(aAjOJe);
+        auto aAjOIeF = Vec3::fromFullMatrixColumn(frmI->aAOe, axisI);
+        auto aAjOJeF = Vec3::fromFullMatrixColumn(frmJ->aAOe, axisJ);
+        aAjOIeF.copyInto(aAjOIe);
+        aAjOJeF.copyInto(aAjOJe);
+        aAijIeJe = aAjOIeF.dot(aAjOJeF);
     }
 
     double MbD::DirectionCosineIecJec::value()
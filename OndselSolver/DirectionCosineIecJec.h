@@ -22,6 +22,7 @@ namespace MbD {
         DirectionCosineIecJec();
         DirectionCosineIecJec(EndFrmsptr frmi, EndFrmsptr frmj, int axisi, int axisj);
 
+        void initialize() override;
         void calcPostDynCorrectorIteration() override;
         double value() override;
 
@@ -8,6 +8,7 @@
  
 #include "DirectionCosineIeqcJec.h"
 #include "EndFrameqc.h"
+#include "FixedMatrix.h"
 
 using namespace MbD;
 
@@ -25,6 +26,7 @@ void DirectionCosineIeqcJec::initialize()
 	DirectionCosineIecJec::initialize();
 	pAijIeJepEI = std::make_shared<FullRow<double>>(4);
 	ppAijIeJepEIpEI = std::make_shared<FullMatrix<double>>(4, 4);
+	pAjOIepEIT = std::make_shared<FullMatrix<double>>(4, 3);
 }
 
 void DirectionCosineIeqcJec::initializeGlobally()
@@ -45,11 +47,15 @@ FRowDsptr MbD::DirectionCosineIeqcJec::pvaluepEI()
 void DirectionCosineIeqcJec::calcPostDynCorrectorIteration()
 {
 	DirectionCosineIecJec::calcPostDynCorrectorIteration();
-	pAjOIepEIT = std::static_pointer_cast<EndFrameqc>(frmI)->pAjOepET(axisI);
+	auto& pAOIepE = std::static_pointer_cast<EndFrameqc>(frmI)->pAOepE;
+	auto aAjOJeF = Vec3::fromFullColumn(aAjOJe);
 	for (int i = 0; i < 4; i++)
 	{
-		pAijIeJepEI->at(i) = pAjOIepEIT->at(i)->dot(aAjOJe);
+		auto pAjOIepEITi = Vec3::fromFullMatrixColumn(pAOIepE->at(i), axisI);
+		pAjOIepEITi.copyInto(pAjOIepEIT->at(i));
+		pAijIeJepEI->at(i) = pAjOIepEITi.dot(aAjOJeF);
 	}
+	if (!this->needsSecondDerivatives()) return;
 	for (int i = 0; i < 4; i++)
 	{
 		auto& ppAijIeJepEIipEI = ppAijIeJepEIpEI->at(i);
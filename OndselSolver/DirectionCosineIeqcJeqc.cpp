@@ -8,6 +8,7 @@
  
 #include "DirectionCosineIeqcJeqc.h"
 #include "EndFrameqc.h"
+#include "FixedMatrix.h"
 
 using namespace MbD;
 
@@ -26,6 +27,7 @@ void DirectionCosineIeqcJeqc::initialize()
 	pAijIeJepEJ = std::make_shared<FullRow<double>>(4);
 	ppAijIeJepEIpEJ = std::make_shared<FullMatrix<double>>(4, 4);
 	ppAijIeJepEJpEJ = std::make_shared<FullMatrix<double>>(4, 4);
+	pAjOJepEJT = std::make_shared<FullMatrix<double>>(4, 3);
 }
 
 void DirectionCosineIeqcJeqc::initializeGlobally()
@@ -42,11 +44,15 @@ FMatDsptr MbD::DirectionCosineIeqcJeqc::ppvaluepEIpEJ()
 void DirectionCosineIeqcJeqc::calcPostDynCorrectorIteration()
 {
 	DirectionCosineIeqcJec::calcPostDynCorrectorIteration();
-	pAjOJepEJT = std::static_pointer_cast<EndFrameqc>(frmJ)->pAjOepET(axisJ);
+	auto& pAOJepE = std::static_pointer_cast<EndFrameqc>(frmJ)->pAOepE;
+	auto aAjOIeF = Vec3::fromFullColumn(aAjOIe);
 	for (int i = 0; i < 4; i++)
 	{
-		pAijIeJepEJ->at(i) = aAjOIe->dot(pAjOJepEJT->at(i));
+		auto pAjOJepEJTi = Vec3::fromFullMatrixColumn(pAOJepE->at(i), axisJ);
+		pAjOJepEJTi.copyInto(pAjOJepEJT->at(i));
+		pAijIeJepEJ->at(i) = aAjOIeF.dot(pAjOJepEJTi);
 	}
+	if (!this->needsSecondDerivatives()) return;
 	for (int i = 0; i < 4; i++)
 	{
 		auto& ppAijIeJepEIipEJ = ppAijIeJepEIpEJ->at(i);
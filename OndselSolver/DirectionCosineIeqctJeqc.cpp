@@ -52,7 +52,13 @@ void DirectionCosineIeqctJeqc::calcPostDynCorrectorIteration()
 {
 	//"ppAjOIepEIpEI is not longer constant and must be set before any calculation."
 
-	ppAjOIepEIpEI = std::static_pointer_cast<EndFrameqc>(frmI)->ppAjOepEpE(axisI);
+	auto frmIqc = std::static_pointer_cast<EndFrameqc>(frmI);
+	if (ppAjOIepEIpEI == nullptr) {
+		ppAjOIepEIpEI = frmIqc->ppAjOepEpE(axisI);
+	}
+	else {
+		frmIqc->ppAjOepEpEInto(axisI, ppAjOIepEIpEI);
+	}
 	DirectionCosineIeqcJeqc::calcPostDynCorrectorIteration();
 }
 
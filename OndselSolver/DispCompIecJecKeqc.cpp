@@ -23,6 +23,9 @@ void DispCompIecJecKeqc::initialize()
 {
     priIeJeKepEK = std::make_shared<FullRow<double>>(4);
     ppriIeJeKepEKpEK = std::make_shared<FullMatrix<double>>(4, 4);
+    aAjOKe = std::make_shared<FullColumn<double>>(3);
+    rIeJeO = std::make_shared<FullColumn<double>>(3);
+    pAjOKepEKT = std::make_shared<FullMatrix<double>>(4, 3);
 }
 
 void DispCompIecJecKeqc::initializeGlobally()
@@ -35,14 +38,18 @@ void DispCompIecJecKeqc::calcPostDynCorrectorIteration()
 	auto frmIqc = std::static_pointer_cast<EndFrameqc>(frmI);
 	auto frmJqc = std::static_pointer_cast<EndFrameqc>(frmJ);
 	auto efrmKqc = std::static_pointer_cast<EndFrameqc>(efrmK);
-	aAjOKe = efrmKqc->aAjOe(axisK);
-	rIeJeO = frmJqc->rOeO->minusFullColumn(frmIqc->rOeO);
+	efrmKqc->aAjOeInto(axisK, aAjOKe);
+	frmJqc->rOeO->minusFullColumnInto(frmIqc->rOeO, rIeJeO);
 	riIeJeKe = aAjOKe->dot(rIeJeO);
-	pAjOKepEKT = efrmKqc->pAjOepET(axisK);
-	ppAjOKepEKpEK = efrmKqc->ppAjOepEpE(axisK);
+	efrmKqc->pAjOepETInto(axisK, pAjOKepEKT);
 	for (int i = 0; i < 4; i++)
 	{
 		priIeJeKepEK->at(i) = ((pAjOKepEKT->at(i))->dot(rIeJeO));
+	}
+	if (!this->needsSecondDerivatives()) return;
+	efrmKqc->ppAjOepEpEInto(axisK, ppAjOKepEKpEK);
+	for (int i = 0; i < 4; i++)
+	{
 		auto& ppAjOKepEKipEK = ppAjOKepEKpEK->at(i);
 		auto& ppriIeJeKepEKipEK = ppriIeJeKepEKpEK->at(i);
 		ppriIeJeKepEKipEK->at(i) = ((ppAjOKepEKipEK->at(i))->dot(rIeJeO));
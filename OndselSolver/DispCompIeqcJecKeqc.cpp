@@ -8,6 +8,7 @@
  
 #include "DispCompIeqcJecKeqc.h"
 #include "EndFrameqc.h"
+#include "FixedMatrix.h"
 
 using namespace MbD;
 
@@ -33,7 +34,9 @@ void DispCompIeqcJecKeqc::calcPostDynCorrectorIteration()
 {
 	DispCompIecJecKeqc::calcPostDynCorrectorIteration();
 	auto frmIqc = std::static_pointer_cast<EndFrameqc>(frmI);
-	auto mprIeJeOpEIT = frmIqc->prOeOpE->transpose();
+	auto mprIeJeOpEIF = Mat3x4::fromFullMatrix(frmIqc->prOeOpE);
+	auto aAjOKeF = Vec3::fromFullColumn(aAjOKe);
+	auto pAjOKepEKF = Mat4x3::fromFullMatrix(pAjOKepEKT);
 	auto& mpprIeJeOpEIpEI = frmIqc->pprOeOpEpE;
 	for (int i = 0; i < 3; i++)
 	{
@@ -41,14 +44,15 @@ void DispCompIeqcJecKeqc::calcPostDynCorrectorIteration()
 	}
 	for (int i = 0; i < 4; i++)
 	{
-		priIeJeKepEI->at(i) = 0.0 - (aAjOKe->dot(mprIeJeOpEIT->at(i)));
+		priIeJeKepEI->at(i) = 0.0 - (aAjOKeF.dot(mprIeJeOpEIF.column(i)));
 	}
+	if (!this->needsSecondDerivatives()) return;
 	for (int i = 0; i < 3; i++)
 	{
 		auto& ppriIeJeKepXIipEK = ppriIeJeKepXIpEK->at(i);
 		for (int j = 0; j < 4; j++)
 		{
-			ppriIeJeKepXIipEK->at(j) = 0.0 - (pAjOKepEKT->at(j)->at(i));
+			ppriIeJeKepXIipEK->at(j) = 0.0 - (pAjOKepEKF.at(j, i));
 		}
 	}
 	for (int i = 0; i < 4; i++)
@@ -65,11 +69,11 @@ void DispCompIeqcJecKeqc::calcPostDynCorrectorIteration()
 	}
 	for (int i = 0; i < 4; i++)
 	{
-		auto& mprIeJeOpEITi = mprIeJeOpEIT->at(i);
+		auto mprIeJeOpEITi = mprIeJeOpEIF.column(i);
 		auto& ppriIeJeKepEIipEK = ppriIeJeKepEIpEK->at(i);
 		for (int j = 0; j < 4; j++)
 		{
-			ppriIeJeKepEIipEK->at(j) = 0.0 - (pAjOKepEKT->at(j)->dot(mprIeJeOpEITi));
+			ppriIeJeKepEIipEK->at(j) = 0.0 - (pAjOKepEKF.row(j).dot(mprIeJeOpEITi));
 		}
 	}
 }
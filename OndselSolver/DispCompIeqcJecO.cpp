@@ -19,6 +19,12 @@ DispCompIeqcJecO::DispCompIeqcJecO(EndFrmsptr frmi, EndFrmsptr frmj, int axis) :
 {
 }
 
+void DispCompIeqcJecO::initialize()
+{
+	DispCompIecJecO::initialize();
+	priIeJeOpEI = std::make_shared<FullRow<double>>(4);
+}
+
 void DispCompIeqcJecO::initializeGlobally()
 {
 	priIeJeOpXI = std::make_shared<FullRow<double>>(3, 0.0);
@@ -44,5 +50,5 @@ FRowDsptr MbD::DispCompIeqcJecO::pvaluepXI()
 void DispCompIeqcJecO::calcPostDynCorrectorIteration()
 {
 	DispCompIecJecO::calcPostDynCorrectorIteration();
-	priIeJeOpEI = std::static_pointer_cast<EndFrameqc>(frmI)->priOeOpE(axis)->negated();
+	std::static_pointer_cast<EndFrameqc>(frmI)->priOeOpE(axis)->negatedInto(priIeJeOpEI);
 }
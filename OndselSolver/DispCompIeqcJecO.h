@@ -19,6 +19,7 @@ namespace MbD {
         DispCompIeqcJecO(EndFrmsptr frmi, EndFrmsptr frmj, int axis);
 
         void calcPostDynCorrectorIteration() override;
+        void initialize() override;
         void initializeGlobally() override;
         FMatDsptr ppvaluepEIpEI() override;
         FRowDsptr pvaluepEI() override;
@@ -8,6 +8,7 @@
  
 #include "DispCompIeqcJeqcKeqc.h"
 #include "EndFrameqc.h"
+#include "FixedMatrix.h"
 
 using namespace MbD;
 
@@ -33,7 +34,9 @@ void DispCompIeqcJeqcKeqc::calcPostDynCorrectorIteration()
 {
 	DispCompIeqcJecKeqc::calcPostDynCorrectorIteration();
 	auto frmJqc = std::static_pointer_cast<EndFrameqc>(frmJ);
-	auto prIeJeOpEJT = frmJqc->prOeOpE->transpose();
+	auto prIeJeOpEJF = Mat3x4::fromFullMatrix(frmJqc->prOeOpE);
+	auto aAjOKeF = Vec3::fromFullColumn(aAjOKe);
+	auto pAjOKepEKF = Mat4x3::fromFullMatrix(pAjOKepEKT);
 	auto& pprIeJeOpEJpEJ = frmJqc->pprOeOpEpE;
 	for (int i = 0; i < 3; i++)
 	{
@@ -41,14 +44,15 @@ void DispCompIeqcJeqcKeqc::calcPostDynCorrectorIteration()
 	}
 	for (int i = 0; i < 4; i++)
 	{
-		priIeJeKepEJ->atiput(i, aAjOKe->dot(prIeJeOpEJT->at(i)));
+		priIeJeKepEJ->atiput(i, aAjOKeF.dot(prIeJeOpEJF.column(i)));
 	}
+	if (!this->needsSecondDerivatives()) return;
 	for (int i = 0; i < 3; i++)
 	{
 		auto& ppriIeJeKepXJipEK = ppriIeJeKepXJpEK->at(i);
 		for (int j = 0; j < 4; j++)
 		{
-			ppriIeJeKepXJipEK->atiput(j, pAjOKepEKT->at(j)->at(i));
+			ppriIeJeKepXJipEK->atiput(j, pAjOKepEKF.at(j, i));
 		}
 	}
 	for (int i = 0; i < 4; i++)
@@ -65,11 +69,11 @@ void DispCompIeqcJeqcKeqc::calcPostDynCorrectorIteration()
 	}
 	for (int i = 0; i < 4; i++)
 	{
-		auto& prIeJeOpEJTi = prIeJeOpEJT->at(i);
+		auto prIeJeOpEJTi = prIeJeOpEJF.column(i);
 		auto& ppriIeJeKepEJipEK = ppriIeJeKepEJpEK->at(i);
 		for (int j = 0; j < 4; j++)
 		{
-			ppriIeJeKepEJipEK->atiput(j, pAjOKepEKT->at(j)->dot(prIeJeOpEJTi));
+			ppriIeJeKepEJipEK->atiput(j, pAjOKepEKF.row(j).dot(prIeJeOpEJTi));
 		}
 	}
 }
@@ -39,7 +39,12 @@ void DispCompIeqcJeqcKeqct::calcPostDynCorrectorIteration()
 {
 	//"ppAjOIepEKpEK is not longer constant and must be set before any calculation."
 	auto efrmKqc = std::static_pointer_cast<EndFrameqc>(efrmK);
-	ppAjOKepEKpEK = efrmKqc->ppAjOepEpE(axisK);
+	if (ppAjOKepEKpEK == nullptr) {
+		ppAjOKepEKpEK = efrmKqc->ppAjOepEpE(axisK);
+	}
+	else {
+		efrmKqc->ppAjOepEpEInto(axisK, ppAjOKepEKpEK);
+	}
 	DispCompIeqcJeqcKeqc::calcPostDynCorrectorIteration();
 }
 
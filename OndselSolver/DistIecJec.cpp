@@ -19,9 +19,17 @@ MbD::DistIecJec::DistIecJec(EndFrmsptr frmi, EndFrmsptr frmj) : KinematicIeJe(fr
 {
 }
 
+void MbD::DistIecJec::initialize()
+{
+	KinematicIeJe::initialize();
+	rIeJeO = std::make_shared<FullColumn<double>>(3);
+	uIeJeO = std::make_shared<FullColumn<double>>(3);
+	muIeJeO = std::make_shared<FullColumn<double>>(3);
+}
+
 void MbD::DistIecJec::calcPostDynCorrectorIteration()
 {
-	rIeJeO = frmJ->rOeO->minusFullColumn(frmI->rOeO);
+	frmJ->rOeO->minusFullColumnInto(frmI->rOeO, rIeJeO);
 	rIeJe = rIeJeO->length();
 	this->calcPrivate();
 }
@@ -29,8 +37,8 @@ void MbD::DistIecJec::calcPostDynCorrectorIteration()
 void MbD::DistIecJec::calcPrivate()
 {
 	if (rIeJe == 0.0) return;
-	uIeJeO = rIeJeO->times(1.0 / rIeJe);
-	muIeJeO = uIeJeO->negated();
+	rIeJeO->timesInto(1.0 / rIeJe, uIeJeO);
+	uIeJeO->negatedInto(muIeJeO);
 }
 
 double MbD::DistIecJec::value()
@@ -18,6 +18,7 @@ namespace MbD {
         DistIecJec();
         DistIecJec(EndFrmsptr frmi, EndFrmsptr frmj);
 
+        void initialize() override;
         void calcPostDynCorrectorIteration() override;
         virtual void calcPrivate();
         double value() override;
@@ -8,6 +8,7 @@
  
 #include "DistIeqcJec.h"
 #include "EndFrameqc.h"
+#include "FixedMatrix.h"
 
 using namespace MbD;
 
@@ -25,11 +26,11 @@ void MbD::DistIeqcJec::calcPrivate()
 	if (rIeJe == 0.0) return;
 	auto frmIeqc = std::static_pointer_cast<EndFrameqc>(frmI);
 	auto& mprIeJeOpEI = frmIeqc->prOeOpE;
-	auto mprIeJeOpEIT = mprIeJeOpEI->transpose();
+	auto mprIeJeOpEIF = Mat3x4::fromFullMatrix(mprIeJeOpEI);
 	auto& mpprIeJeOpEIpEI = frmIeqc->pprOeOpEpE;
-	auto muIeJeOT = muIeJeO->transpose();
-	prIeJepXI = muIeJeOT;
-	prIeJepEI = muIeJeOT->timesFullMatrix(mprIeJeOpEI);
+	muIeJeO->transposeInto(prIeJepXI);
+	prIeJepXI->timesFullMatrixInto(mprIeJeOpEI, prIeJepEI);
+	if (!this->needsSecondDerivatives()) return;
 	for (int i = 0; i < 3; i++)
 	{
 		auto& pprIeJepXIipXI = pprIeJepXIpXI->at(i);
@@ -41,7 +42,6 @@ void MbD::DistIeqcJec::calcPrivate()
 			pprIeJepXIipXI->atiput(j, element / rIeJe);
 		}
 	}
-	pprIeJepXIpEI = std::make_shared<FullMatrix<double>>(3, 4);
 	for (int i = 0; i < 3; i++)
 	{
 		auto& pprIeJepXIipEI = pprIeJepXIpEI->at(i);
@@ -53,16 +53,15 @@ void MbD::DistIeqcJec::calcPrivate()
 			pprIeJepXIipEI->atiput(j, element / rIeJe);
 		}
 	}
-	pprIeJepEIpEI = std::make_shared<FullMatrix<double>>(4, 4);
 	for (int i = 0; i < 4; i++)
 	{
 		auto& pprIeJepEIipEI = pprIeJepEIpEI->at(i);
 		auto& prIeJepEIi = prIeJepEI->at(i);
 		auto& mpprIeJeOpEIipEI = mpprIeJeOpEIpEI->at(i);
-		auto& mprIeJeOpEIiT = mprIeJeOpEIT->at(i);
+		auto mprIeJeOpEIiT = mprIeJeOpEIF.column(i);
 		for (int j = 0; j < 4; j++)
 		{
-			auto element = mprIeJeOpEIiT->dot(mprIeJeOpEIT->at(j))
+			auto element = mprIeJeOpEIiT.dot(mprIeJeOpEIF.column(j))
                            - mpprIeJeOpEIipEI->at(j)->dot(rIeJeO) - prIeJepEIi * prIeJepEI->at(j);
 			pprIeJepEIipEI->atiput(j, element / rIeJe);
 		}
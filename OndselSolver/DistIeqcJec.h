@@ -13,7 +13,7 @@
 namespace MbD {
     class DistIeqcJec : public DistIecJec
     {
-        //prIeJepXI prIeJepEI pprIeJepXIpXI pprIeJepXIpEI pprIeJepEIpEI mprIeJeOpEIT 
+        //prIeJepXI prIeJepEI pprIeJepXIpXI pprIeJepXIpEI pprIeJepEIpEI 
     public:
         DistIeqcJec();
         DistIeqcJec(EndFrmsptr frmi, EndFrmsptr frmj);
@@ -27,7 +27,7 @@ namespace MbD {
         FRowDsptr pvaluepXI() override;
 
         FRowDsptr prIeJepXI, prIeJepEI;
-        FMatDsptr pprIeJepXIpXI, pprIeJepXIpEI, pprIeJepEIpEI, mprIeJeOpEIT;
+        FMatDsptr pprIeJepXIpXI, pprIeJepXIpEI, pprIeJepEIpEI;
     };
 }
 
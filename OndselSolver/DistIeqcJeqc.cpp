@@ -8,6 +8,7 @@
  
 #include "DistIeqcJeqc.h"
 #include "EndFrameqc.h"
+#include "FixedMatrix.h"
 
 using namespace MbD;
 
@@ -23,13 +24,15 @@ void MbD::DistIeqcJeqc::calcPrivate()
 {
 	DistIeqcJec::calcPrivate();
 	if (rIeJe == 0.0) return;
+	auto frmIeqc = std::static_pointer_cast<EndFrameqc>(frmI);
+	auto mprIeJeOpEIF = Mat3x4::fromFullMatrix(frmIeqc->prOeOpE);
 	auto frmJeqc = std::static_pointer_cast<EndFrameqc>(frmJ);
 	auto& prIeJeOpEJ = frmJeqc->prOeOpE;
-	auto prIeJeOpEJT = prIeJeOpEJ->transpose();
+	auto prIeJeOpEJF = Mat3x4::fromFullMatrix(prIeJeOpEJ);
 	auto& pprIeJeOpEJpEJ = frmJeqc->pprOeOpEpE;
-	auto uIeJeOT = uIeJeO->transpose();
-	prIeJepXJ = uIeJeOT;
-	prIeJepEJ = uIeJeOT->timesFullMatrix(prIeJeOpEJ);
+	uIeJeO->transposeInto(prIeJepXJ);
+	prIeJepXJ->timesFullMatrixInto(prIeJeOpEJ, prIeJepEJ);
+	if (!this->needsSecondDerivatives()) return;
 	for (int i = 0; i < 3; i++)
 	{
 		auto& pprIeJepXIipXJ = pprIeJepXIpXJ->at(i);
@@ -46,10 +49,9 @@ void MbD::DistIeqcJeqc::calcPrivate()
 	{
 		auto& pprIeJepEIipXJ = pprIeJepEIpXJ->at(i);
 		auto& prIeJepEIi = prIeJepEI->at(i);
-		auto& mprIeJeOpEIiT = mprIeJeOpEIT->at(i);
 		for (int j = 0; j < 3; j++)
 		{
-			auto element = 0.0 - mprIeJeOpEIiT->at(j) - prIeJepEIi * prIeJepXJ->at(j);
+			auto element = 0.0 - mprIeJeOpEIF.at(j, i) - prIeJepEIi * prIeJepXJ->at(j);
 			pprIeJepEIipXJ->atiput(j, element / rIeJe);
 		}
 	}
@@ -82,10 +84,10 @@ void MbD::DistIeqcJeqc::calcPrivate()
 	{
 		auto& pprIeJepEIipEJ = pprIeJepEIpEJ->at(i);
 		auto& prIeJepEIi = prIeJepEI->at(i);
-		auto& mprIeJeOpEIiT = mprIeJeOpEIT->at(i);
+		auto mprIeJeOpEIiT = mprIeJeOpEIF.column(i);
 		for (int j = 0; j < 4; j++)
 		{
-			auto element = 0.0 - mprIeJeOpEIiT->dot(prIeJeOpEJT->at(j)) - prIeJepEIi * prIeJepEJ->at(j);
+			auto element = 0.0 - mprIeJeOpEIiT.dot(prIeJeOpEJF.column(j)) - prIeJepEIi * prIeJepEJ->at(j);
 			pprIeJepEIipEJ->atiput(j, element / rIeJe);
 		}
 	}
@@ -107,10 +109,10 @@ void MbD::DistIeqcJeqc::calcPrivate()
 		auto& pprIeJepEJipEJ = pprIeJepEJpEJ->at(i);
 		auto& prIeJepEJi = prIeJepEJ->at(i);
 		auto& pprIeJeOpEJipEJ = pprIeJeOpEJpEJ->at(i);
-		auto& prIeJeOpEJiT = prIeJeOpEJT->at(i);
+		auto prIeJeOpEJiT = prIeJeOpEJF.column(i);
 		for (int j = 0; j < 4; j++)
 		{
-			auto element = prIeJeOpEJiT->dot(prIeJeOpEJT->at(j))
+			auto element = prIeJeOpEJiT.dot(prIeJeOpEJF.column(j))
                            + pprIeJeOpEJipEJ->at(j)->dot(rIeJeO) - prIeJepEJi * prIeJepEJ->at(j);
 			pprIeJepEJipEJ->atiput(j, element / rIeJe);
 		}
@@ -28,6 +28,7 @@ void MbD::DistanceConstraintIJ::initialize()
 {
 	ConstraintIJ::initialize();
 	this->init_distIeJe();
+	distIeJe->owner = this;
 }
 
 void MbD::DistanceConstraintIJ::initializeGlobally()
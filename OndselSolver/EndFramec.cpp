@@ -71,6 +71,13 @@ FColDsptr EndFramec::aAjOe(int j)
 	return aAOe->column(j);
 }
 
+void EndFramec::aAjOeInto(int j, FColDsptr answer)
+{
+	for (int i = 0; i < 3; i++) {
+		answer->at(i) = aAOe->at(i)->at(j);
+	}
+}
+
 double EndFramec::riOeO(int i)
 {
 	return rOeO->at(i);
@@ -35,6 +35,7 @@ namespace MbD {
 		virtual void initEndFrameqct2();
 		void calcPostDynCorrectorIteration() override;
 		FColDsptr aAjOe(int j);
+		void aAjOeInto(int j, FColDsptr answer);
 		double riOeO(int i);
 		virtual FColDsptr rmeO();
 		virtual FColDsptr rpep();
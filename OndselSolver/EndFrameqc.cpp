@@ -71,6 +71,22 @@ FMatFColDsptr EndFrameqc::ppAjOepEpE(int jj)
 	return answer;
 }
 
+void EndFrameqc::ppAjOepEpEInto(int jj, FMatFColDsptr answer)
+{
+	//"answer comes from ppAjOepEpE. Its lower half shares the columns of its upper half."
+	for (int i = 0; i < 4; i++) {
+		auto& answeri = answer->at(i);
+		auto& ppAOepEipE = ppAOepEpE->at(i);
+		for (int j = i; j < 4; j++) {
+			auto& answerij = answeri->at(j);
+			auto& ppAOepEipEj = ppAOepEipE->at(j);
+			for (int k = 0; k < 3; k++) {
+				answerij->at(k) = ppAOepEipEj->at(k)->at(jj);
+			}
+		}
+	}
+}
+
 void EndFrameqc::calcPostDynCorrectorIteration()
 {
 	EndFramec::calcPostDynCorrectorIteration();
@@ -81,6 +97,12 @@ void EndFrameqc::calcPostDynCorrectorIteration()
 FMatDsptr EndFrameqc::pAjOepET(int axis)
 {
 	auto answer = std::make_shared<FullMatrix<double>>(4, 3);
+	this->pAjOepETInto(axis, answer);
+	return answer;
+}
+
+void EndFrameqc::pAjOepETInto(int axis, FMatDsptr answer)
+{
 	for (int i = 0; i < 4; i++) {
 		auto& answeri = answer->at(i);
 		auto& pAOepEi = pAOepE->at(i);
@@ -89,7 +111,6 @@ FMatDsptr EndFrameqc::pAjOepET(int axis)
 			answeri->at(j) = answerij;
 		}
 	}
-	return answer;
 }
 
 FMatDsptr EndFrameqc::ppriOeOpEpE(int ii)
@@ -27,8 +27,10 @@ namespace MbD {
         void initEndFrameqct() override;
         void initEndFrameqct2() override;
         FMatFColDsptr ppAjOepEpE(int j);
+        void ppAjOepEpEInto(int j, FMatFColDsptr answer);
         void calcPostDynCorrectorIteration() override;
         FMatDsptr pAjOepET(int j);
+        void pAjOepETInto(int j, FMatDsptr answer);
         FMatDsptr ppriOeOpEpE(int i);
         int iqX();
         int iqE();
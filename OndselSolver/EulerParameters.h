@@ -11,6 +11,7 @@
 #include "EulerArray.h"
 #include "FullColumn.h"
 #include "FullMatrix.h"
+#include "FixedMatrix.h"
 
 namespace MbD {
 
@@ -237,40 +238,36 @@ namespace MbD {
 		double mE0 = -aE0;
 		double mE1 = -aE1;
 		double mE2 = -aE2;
-		FRowDsptr aBi;
-		aBi = aB->at(0);
-		aBi->at(0) = aE3;
-		aBi->at(1) = mE2;
-		aBi->at(2) = aE1;
-		aBi->at(3) = mE0;
-		aBi = aB->at(1);
-		aBi->at(0) = aE2;
-		aBi->at(1) = aE3;
-		aBi->at(2) = mE0;
-		aBi->at(3) = mE1;
-		aBi = aB->at(2);
-		aBi->at(0) = mE1;
-		aBi->at(1) = aE0;
-		aBi->at(2) = aE3;
-		aBi->at(3) = mE2;
-		FRowDsptr aCi;
-		aCi = aC->at(0);
-		aCi->at(0) = aE3;
-		aCi->at(1) = aE2;
-		aCi->at(2) = mE1;
-		aCi->at(3) = mE0;
-		aCi = aC->at(1);
-		aCi->at(0) = mE2;
-		aCi->at(1) = aE3;
-		aCi->at(2) = aE0;
-		aCi->at(3) = mE1;
-		aCi = aC->at(2);
-		aCi->at(0) = aE1;
-		aCi->at(1) = mE0;
-		aCi->at(2) = aE3;
-		aCi->at(3) = mE2;
-
-		aA = aB->timesTransposeFullMatrix(aC);
+		Mat3x4 aBF;
+		aBF.at(0, 0) = aE3;
+		aBF.at(0, 1) = mE2;
+		aBF.at(0, 2) = aE1;
+		aBF.at(0, 3) = mE0;
+		aBF.at(1, 0) = aE2;
+		aBF.at(1, 1) = aE3;
+		aBF.at(1, 2) = mE0;
+		aBF.at(1, 3) = mE1;
+		aBF.at(2, 0) = mE1;
+		aBF.at(2, 1) = aE0;
+		aBF.at(2, 2) = aE3;
+		aBF.at(2, 3) = mE2;
+		Mat3x4 aCF;
+		aCF.at(0, 0) = aE3;
+		aCF.at(0, 1) = aE2;
+		aCF.at(0, 2) = mE1;
+		aCF.at(0, 3) = mE0;
+		aCF.at(1, 0) = mE2;
+		aCF.at(1, 1) = aE3;
+		aCF.at(1, 2) = aE0;
+		aCF.at(1, 3) = mE1;
+		aCF.at(2, 0) = aE1;
+		aCF.at(2, 1) = mE0;
+		aCF.at(2, 2) = aE3;
+		aCF.at(2, 3) = mE2;
+		//"aA, aB and aC are filled in place like pApE. Holders of them see the new values."
+		aBF.copyInto(aB);
+		aCF.copyInto(aC);
+		aBF.timesTransposeFixedMatrix(aCF).copyInto(aA);
 	}
 	template<>
 	inline void EulerParameters<double>::calcpApE()
@@ -12,6 +12,7 @@
 #include "FullColumn.h"
 #include "FullMatrix.h"
 #include "EulerParameters.h"
+#include "LazyMatrix.h"
 //#include "CREATE.h" //Cannot use CREATE.h in subclasses of std::vector. Why?
 
 namespace MbD {
@@ -100,7 +101,7 @@ namespace MbD {
 		aCdot->at(2)->at(1) = mE0dot;
 		aCdot->at(2)->at(2) = aE3dot;
 		aCdot->at(2)->at(3) = mE2dot;
-		aAdot = this->aB()->timesTransposeFullMatrix(aCdot)->times(2.0);
+		aAdot = lazy(this->aB()).timesTransposeFullMatrix(lazy(aCdot)).times(2.0).evaluate();
 	}
 
 	template<typename T>
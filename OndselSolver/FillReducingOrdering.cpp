@@ -0,0 +1,128 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+ 
+#include <set>
+#include <cassert>
+
+#include "FillReducingOrdering.h"
+
+using namespace MbD;
+
+void FillReducingOrdering::analyze(SpMatDsptr spMat)
+{
+	//"Eliminate the node of least degree in the elimination graph. Ties go to the lower index."
+	//"Its neighbours become a clique. The new edges are the predicted fill."
+	//"Matrices here have hundreds of equations so the explicit graph is used instead of a quotient graph."
+	n = spMat->ncol();
+	assert(spMat->nrow() == n);
+	std::vector<std::set<int>> adjacents(n);
+	patternStarts.assign(1, 0);
+	patternCols.clear();
+	for (int i = 0; i < n; i++)
+	{
+		spMat->rowDo(i, [&](int j, double) {
+			patternCols.push_back(j);
+			if (i == j) return;
+			adjacents[i].insert(j);
+			adjacents[j].insert(i);
+			});
+		patternStarts.push_back((int)patternCols.size());
+	}
+	std::set<std::pair<int, int>> degreesAndNodes;
+	for (int i = 0; i < n; i++)
+	{
+		degreesAndNodes.insert({ (int)adjacents[i].size(), i });
+	}
+	colOrder.assign(n, -1);
+	colPositions.assign(n, -1);
+	predictedFill = n;
+	for (int k = 0; k < n; k++)
+	{
+		auto node = degreesAndNodes.begin()->second;
+		degreesAndNodes.erase(degreesAndNodes.begin());
+		colOrder[k] = node;
+		colPositions[node] = k;
+		auto& neighbours = adjacents[node];
+		predictedFill += 2 * (int)neighbours.size();
+		for (auto i : neighbours)
+		{
+			auto& adjacentsi = adjacents[i];
+			degreesAndNodes.erase({ (int)adjacentsi.size(), i });
+			adjacentsi.erase(node);
+			for (auto j : neighbours)
+			{
+				if (j != i) adjacentsi.insert(j);
+			}
+			degreesAndNodes.insert({ (int)adjacentsi.size(), i });
+		}
+		neighbours.clear();
+	}
+	actualFill = -1;
+	fillReported = true;
+	nAnalysis++;
+}
+
+bool FillReducingOrdering::isValidFor(SpMatDsptr spMat)
+{
+	//"Same order and the same pattern as analyzed. Values do not matter."
+	if (n <= 0 || n != spMat->nrow() || n != spMat->ncol()) return false;
+	for (int i = 0; i < n; i++)
+	{
+		auto k = patternStarts[i];
+		auto kEnd = patternStarts[i + 1];
+		auto isSame = true;
+		spMat->rowDo(i, [&](int j, double) {
+			if (k < kEnd && patternCols[k] == j) {
+				k++;
+			}
+			else {
+				isSame = false;
+			}
+			});
+		if (!isSame || k != kEnd) return false;
+	}
+	return true;
+}
+
+void FillReducingOrdering::invalidate()
+{
+	n = -1;
+}
+
+void FillReducingOrdering::permuteColumnsOf(CSpMatDsptr matrix)
+{
+	//"Column j moves to colPositions[j]."
+	matrix->permuteColumns(colPositions);
+}
+
+FColDsptr FillReducingOrdering::unpermuted(FColDsptr fullCol)
+{
+	auto answer = std::make_shared<FullColumn<double>>(n);
+	for (int k = 0; k < n; k++)
+	{
+		answer->at(colOrder[k]) = fullCol->at(k);
+	}
+	return answer;
+}
+
+void FillReducingOrdering::actualFillIs(int fill)
+{
+	if (actualFill == fill) return;
+	actualFill = fill;
+	fillReported = false;
+}
+
+std::string FillReducingOrdering::fillReport()
+{
+	fillReported = true;
+	std::string str("MbD: Fill-reducing ordering predicted fill = ");
+	str += std::to_string(predictedFill);
+	str += ", actual fill = ";
+	str += std::to_string(actualFill);
+	return str;
+}
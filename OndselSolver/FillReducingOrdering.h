@@ -0,0 +1,41 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+ 
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "SparseMatrix.h"
+#include "CompressedSparseMatrix.h"
+
+namespace MbD {
+    class FillReducingOrdering
+    {
+        //n colOrder colPositions patternStarts patternCols predictedFill actualFill nAnalysis 
+        //"Minimum degree column pre-ordering computed from the pattern of A + A transpose."
+        //"The pattern of A is kept so that a matrix with another pattern is analyzed again."
+        //"Column colOrder[k] of the original matrix is eliminated at step k. colPositions is the inverse."
+        //"Fill counts are entries of L and U including the diagonal."
+    public:
+        void analyze(SpMatDsptr spMat);
+        bool isValidFor(SpMatDsptr spMat);
+        void invalidate();
+        void permuteColumnsOf(CSpMatDsptr matrix);
+        FColDsptr unpermuted(FColDsptr fullCol);
+        void actualFillIs(int fill);
+        std::string fillReport();
+
+        int n = -1;
+        std::vector<int> colOrder, colPositions;
+        std::vector<int> patternStarts, patternCols;	//Column indices of row i are patternCols[patternStarts[i]] up to patternStarts[i + 1].
+        int predictedFill = -1, actualFill = -1, nAnalysis = 0;
+        bool fillReported = true;
+    };
+}
+
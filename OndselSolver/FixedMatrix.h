@@ -0,0 +1,270 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <memory>
+
+#include "FullColumn.h"
+#include "FullRow.h"
+#include "FullMatrix.h"
+
+namespace MbD {
+	//"Compile time sized column and matrix held by value."
+	//"For the 3 and 4 sized kinematic kernels where FullColumn and FullMatrix temporaries would each be heap allocated."
+	//"Convert from and into the shared_ptr containers at the boundaries only."
+
+	template<typename T, int N>
+	class FixedColumn
+	{
+		//elements
+	public:
+		constexpr FixedColumn() : elements{} {}
+		static FixedColumn fromFullColumn(const FColsptr<T>& fullCol);
+		static FixedColumn fromFullRow(const FRowsptr<T>& fullRow);
+		static FixedColumn fromFullMatrixColumn(const FMatsptr<T>& fullMat, int j);
+		constexpr T& at(int i) { return elements[i]; }
+		constexpr const T& at(int i) const { return elements[i]; }
+		constexpr FixedColumn plusFixedColumn(const FixedColumn& col) const;
+		constexpr FixedColumn minusFixedColumn(const FixedColumn& col) const;
+		constexpr FixedColumn times(T a) const;
+		constexpr T dot(const FixedColumn& col) const;
+		T dot(const FColsptr<T>& fullCol) const;
+		FColsptr<T> toFullColumn() const;
+		FRowsptr<T> toFullRow() const;
+		void copyInto(const std::shared_ptr<FullVector<T>>& fullVec) const;
+
+		std::array<T, N> elements;
+	};
+
+	template<typename T, int M, int N>
+	class FixedMatrix
+	{
+		//elements "Row major."
+	public:
+		constexpr FixedMatrix() : elements{} {}
+		static FixedMatrix fromFullMatrix(const FMatsptr<T>& fullMat);
+		static constexpr FixedMatrix identity();
+		constexpr T& at(int i, int j) { return elements[i * N + j]; }
+		constexpr const T& at(int i, int j) const { return elements[i * N + j]; }
+		constexpr FixedColumn<T, N> row(int i) const;
+		constexpr FixedColumn<T, M> column(int j) const;
+		constexpr FixedMatrix<T, N, M> transpose() const;
+		constexpr FixedColumn<T, M> timesFixedColumn(const FixedColumn<T, N>& col) const;
+		constexpr FixedColumn<T, N> transposeTimesFixedColumn(const FixedColumn<T, M>& col) const;
+		template<int L>
+		constexpr FixedMatrix<T, M, L> timesFixedMatrix(const FixedMatrix<T, N, L>& mat) const;
+		template<int L>
+		constexpr FixedMatrix<T, M, L> timesTransposeFixedMatrix(const FixedMatrix<T, L, N>& mat) const;
+		template<int L>
+		constexpr FixedMatrix<T, N, L> transposeTimesFixedMatrix(const FixedMatrix<T, M, L>& mat) const;
+		FMatsptr<T> toFullMatrix() const;
+		void copyInto(const FMatsptr<T>& fullMat) const;
+
+		std::array<T, M * N> elements;
+	};
+
+	using Vec3 = FixedColumn<double, 3>;
+	using Vec4 = FixedColumn<double, 4>;
+	using Mat3 = FixedMatrix<double, 3, 3>;
+	using Mat3x4 = FixedMatrix<double, 3, 4>;
+	using Mat4x3 = FixedMatrix<double, 4, 3>;
+	using Mat4 = FixedMatrix<double, 4, 4>;
+
+	template<typename T, int N>
+	inline FixedColumn<T, N> FixedColumn<T, N>::fromFullColumn(const FColsptr<T>& fullCol)
+	{
+		FixedColumn<T, N> answer;
+		for (int i = 0; i < N; i++) answer.elements[i] = fullCol->at(i);
+		return answer;
+	}
+	template<typename T, int N>
+	inline FixedColumn<T, N> FixedColumn<T, N>::fromFullRow(const FRowsptr<T>& fullRow)
+	{
+		FixedColumn<T, N> answer;
+		for (int i = 0; i < N; i++) answer.elements[i] = fullRow->at(i);
+		return answer;
+	}
+	template<typename T, int N>
+	inline FixedColumn<T, N> FixedColumn<T, N>::fromFullMatrixColumn(const FMatsptr<T>& fullMat, int j)
+	{
+		FixedColumn<T, N> answer;
+		for (int i = 0; i < N; i++) answer.elements[i] = fullMat->at(i)->at(j);
+		return answer;
+	}
+	template<typename T, int N>
+	inline constexpr FixedColumn<T, N> FixedColumn<T, N>::plusFixedColumn(const FixedColumn& col) const
+	{
+		FixedColumn<T, N> answer;
+		for (int i = 0; i < N; i++) answer.elements[i] = elements[i] + col.elements[i];
+		return answer;
+	}
+	template<typename T, int N>
+	inline constexpr FixedColumn<T, N> FixedColumn<T, N>::minusFixedColumn(const FixedColumn& col) const
+	{
+		FixedColumn<T, N> answer;
+		for (int i = 0; i < N; i++) answer.elements[i] = elements[i] - col.elements[i];
+		return answer;
+	}
+	template<typename T, int N>
+	inline constexpr FixedColumn<T, N> FixedColumn<T, N>::times(T a) const
+	{
+		FixedColumn<T, N> answer;
+		for (int i = 0; i < N; i++) answer.elements[i] = elements[i] * a;
+		return answer;
+	}
+	template<typename T, int N>
+	inline constexpr T FixedColumn<T, N>::dot(const FixedColumn& col) const
+	{
+		T answer = elements[0] * col.elements[0];
+		for (int i = 1; i < N; i++) answer += elements[i] * col.elements[i];
+		return answer;
+	}
+	template<typename T, int N>
+	inline T FixedColumn<T, N>::dot(const FColsptr<T>& fullCol) const
+	{
+		T answer = elements[0] * fullCol->at(0);
+		for (int i = 1; i < N; i++) answer += elements[i] * fullCol->at(i);
+		return answer;
+	}
+	template<typename T, int N>
+	inline FColsptr<T> FixedColumn<T, N>::toFullColumn() const
+	{
+		return std::make_shared<FullColumn<T>>(std::vector<T>(elements.begin(), elements.end()));
+	}
+	template<typename T, int N>
+	inline FRowsptr<T> FixedColumn<T, N>::toFullRow() const
+	{
+		return std::make_shared<FullRow<T>>(std::vector<T>(elements.begin(), elements.end()));
+	}
+	template<typename T, int N>
+	inline void FixedColumn<T, N>::copyInto(const std::shared_ptr<FullVector<T>>& fullVec) const
+	{
+		for (int i = 0; i < N; i++) fullVec->at(i) = elements[i];
+	}
+	template<typename T, int M, int N>
+	inline FixedMatrix<T, M, N> FixedMatrix<T, M, N>::fromFullMatrix(const FMatsptr<T>& fullMat)
+	{
+		FixedMatrix<T, M, N> answer;
+		for (int i = 0; i < M; i++) {
+			auto& rowi = fullMat->at(i);
+			for (int j = 0; j < N; j++) answer.elements[i * N + j] = rowi->at(j);
+		}
+		return answer;
+	}
+	template<typename T, int M, int N>
+	inline constexpr FixedMatrix<T, M, N> FixedMatrix<T, M, N>::identity()
+	{
+		FixedMatrix<T, M, N> answer;
+		for (int i = 0; i < M && i < N; i++) answer.elements[i * N + i] = 1;
+		return answer;
+	}
+	template<typename T, int M, int N>
+	inline constexpr FixedColumn<T, N> FixedMatrix<T, M, N>::row(int i) const
+	{
+		FixedColumn<T, N> answer;
+		for (int j = 0; j < N; j++) answer.elements[j] = elements[i * N + j];
+		return answer;
+	}
+	template<typename T, int M, int N>
+	inline constexpr FixedColumn<T, M> FixedMatrix<T, M, N>::column(int j) const
+	{
+		FixedColumn<T, M> answer;
+		for (int i = 0; i < M; i++) answer.elements[i] = elements[i * N + j];
+		return answer;
+	}
+	template<typename T, int M, int N>
+	inline constexpr FixedMatrix<T, N, M> FixedMatrix<T, M, N>::transpose() const
+	{
+		FixedMatrix<T, N, M> answer;
+		for (int i = 0; i < M; i++) {
+			for (int j = 0; j < N; j++) answer.elements[j * M + i] = elements[i * N + j];
+		}
+		return answer;
+	}
+	template<typename T, int M, int N>
+	inline constexpr FixedColumn<T, M> FixedMatrix<T, M, N>::timesFixedColumn(const FixedColumn<T, N>& col) const
+	{
+		FixedColumn<T, M> answer;
+		for (int i = 0; i < M; i++) {
+			T sum = elements[i * N] * col.elements[0];
+			for (int j = 1; j < N; j++) sum += elements[i * N + j] * col.elements[j];
+			answer.elements[i] = sum;
+		}
+		return answer;
+	}
+	template<typename T, int M, int N>
+	inline constexpr FixedColumn<T, N> FixedMatrix<T, M, N>::transposeTimesFixedColumn(const FixedColumn<T, M>& col) const
+	{
+		FixedColumn<T, N> answer;
+		for (int j = 0; j < N; j++) {
+			T sum = elements[j] * col.elements[0];
+			for (int i = 1; i < M; i++) sum += elements[i * N + j] * col.elements[i];
+			answer.elements[j] = sum;
+		}
+		return answer;
+	}
+	template<typename T, int M, int N>
+	template<int L>
+	inline constexpr FixedMatrix<T, M, L> FixedMatrix<T, M, N>::timesFixedMatrix(const FixedMatrix<T, N, L>& mat) const
+	{
+		FixedMatrix<T, M, L> answer;
+		for (int i = 0; i < M; i++) {
+			for (int j = 0; j < L; j++) {
+				T sum = elements[i * N] * mat.elements[j];
+				for (int k = 1; k < N; k++) sum += elements[i * N + k] * mat.elements[k * L + j];
+				answer.elements[i * L + j] = sum;
+			}
+		}
+		return answer;
+	}
+	template<typename T, int M, int N>
+	template<int L>
+	inline constexpr FixedMatrix<T, M, L> FixedMatrix<T, M, N>::timesTransposeFixedMatrix(const FixedMatrix<T, L, N>& mat) const
+	{
+		FixedMatrix<T, M, L> answer;
+		for (int i = 0; i < M; i++) {
+			for (int j = 0; j < L; j++) {
+				T sum = elements[i * N] * mat.elements[j * N];
+				for (int k = 1; k < N; k++) sum += elements[i * N + k] * mat.elements[j * N + k];
+				answer.elements[i * L + j] = sum;
+			}
+		}
+		return answer;
+	}
+	template<typename T, int M, int N>
+	template<int L>
+	inline constexpr FixedMatrix<T, N, L> FixedMatrix<T, M, N>::transposeTimesFixedMatrix(const FixedMatrix<T, M, L>& mat) const
+	{
+		FixedMatrix<T, N, L> answer;
+		for (int i = 0; i < N; i++) {
+			for (int j = 0; j < L; j++) {
+				T sum = elements[i] * mat.elements[j];
+				for (int k = 1; k < M; k++) sum += elements[k * N + i] * mat.elements[k * L + j];
+				answer.elements[i * L + j] = sum;
+			}
+		}
+		return answer;
+	}
+	template<typename T, int M, int N>
+	inline FMatsptr<T> FixedMatrix<T, M, N>::toFullMatrix() const
+	{
+		auto answer = std::make_shared<FullMatrix<T>>(M, N);
+		this->copyInto(answer);
+		return answer;
+	}
+	template<typename T, int M, int N>
+	inline void FixedMatrix<T, M, N>::copyInto(const FMatsptr<T>& fullMat) const
+	{
+		for (int i = 0; i < M; i++) {
+			auto& rowi = fullMat->at(i);
+			for (int j = 0; j < N; j++) rowi->at(j) = elements[i * N + j];
+		}
+	}
+}
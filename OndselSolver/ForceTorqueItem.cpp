@@ -9,3 +9,9 @@
 #include "ForceTorqueItem.h"
 
 using namespace MbD;
+
+std::shared_ptr<ForceTorqueItem> MbD::ForceTorqueItem::newCopy()
+{
+	//"A copy for each connected component of the system. Null when the item cannot be split that way."
+	return nullptr;
+}
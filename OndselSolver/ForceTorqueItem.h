@@ -15,6 +15,7 @@ namespace MbD {
     {
         //
     public:
+        virtual std::shared_ptr<ForceTorqueItem> newCopy();
 
     };
 }
@@ -50,6 +50,11 @@ namespace MbD {
 		T transposeTimesFullColumn(const FColsptr<T> fullCol);		
 		void equalSelfPlusFullColumntimes(FColsptr<T> fullCol, T factor);
 		FColsptr<T> cross(FColsptr<T> fullCol);
+		void timesInto(T a, FColsptr<T> answer);
+		void negatedInto(FColsptr<T> answer);
+		void plusFullColumnInto(FColsptr<T> fullCol, FColsptr<T> answer);
+		void minusFullColumnInto(FColsptr<T> fullCol, FColsptr<T> answer);
+		void transposeInto(FRowsptr<T> answer);
 		FColsptr<T> simplified();
 		double dot(std::shared_ptr<FullVector<T>> vec);
 		std::shared_ptr<FullVector<T>> dot(std::shared_ptr<std::vector<std::shared_ptr<FullColumn<T>>>> vecvec);
@@ -174,6 +179,44 @@ namespace MbD {
 	{
 		this->equalSelfPlusFullVectortimes(fullCol, factor);
 	}
+	//"The Into variants write into a caller provided answer of the right size instead of allocating."
+	template<typename T>
+	inline void FullColumn<T>::timesInto(T a, FColsptr<T> answer)
+	{
+		int n = (int)this->size();
+		for (int i = 0; i < n; i++) {
+			answer->at(i) = this->at(i) * a;
+		}
+	}
+	template<typename T>
+	inline void FullColumn<T>::negatedInto(FColsptr<T> answer)
+	{
+		this->timesInto(-1.0, answer);
+	}
+	template<typename T>
+	inline void FullColumn<T>::plusFullColumnInto(FColsptr<T> fullCol, FColsptr<T> answer)
+	{
+		int n = (int)this->size();
+		for (int i = 0; i < n; i++) {
+			answer->at(i) = this->at(i) + fullCol->at(i);
+		}
+	}
+	template<typename T>
+	inline void FullColumn<T>::minusFullColumnInto(FColsptr<T> fullCol, FColsptr<T> answer)
+	{
+		int n = (int)this->size();
+		for (int i = 0; i < n; i++) {
+			answer->at(i) = this->at(i) - fullCol->at(i);
+		}
+	}
+	template<typename T>
+	inline void FullColumn<T>::transposeInto(FRowsptr<T> answer)
+	{
+		int n = (int)this->size();
+		for (int i = 0; i < n; i++) {
+			answer->at(i) = this->at(i);
+		}
+	}
 	template<typename T>
 	inline FColsptr<T> FullColumn<T>::cross(FColsptr<T> fullCol)
 	{
@@ -85,6 +85,15 @@ namespace MbD {
 		FMatsptr<T> minusFullMatrix(FMatsptr<T> fullMat);
 		FMatsptr<T> transpose();
 		FMatsptr<T> negated();
+		void timesFullColumnInto(FColsptr<T> fullCol, FColsptr<T> answer);
+		void timesFullMatrixInto(FMatsptr<T> fullMat, FMatsptr<T> answer);
+		void timesTransposeFullMatrixInto(FMatsptr<T> fullMat, FMatsptr<T> answer);
+		void transposeTimesFullMatrixInto(FMatsptr<T> fullMat, FMatsptr<T> answer);
+		void plusFullMatrixInto(FMatsptr<T> fullMat, FMatsptr<T> answer);
+		void minusFullMatrixInto(FMatsptr<T> fullMat, FMatsptr<T> answer);
+		void timesInto(T a, FMatsptr<T> answer);
+		void negatedInto(FMatsptr<T> answer);
+		void transposeInto(FMatsptr<T> answer);
 		void symLowerWithUpper();
 		void atiput(int i, FRowsptr<T> fullRow);
 		void atijput(int i, int j, T value);
@@ -436,6 +445,101 @@ namespace MbD {
 	{
 		return this->times(-1.0);
 	}
+	//"The Into variants write into a caller provided answer of the right size instead of allocating."
+	//"answer may be the receiver or an operand only where the operation is elementwise."
+	template<typename T>
+	inline void FullMatrix<T>::timesFullColumnInto(FColsptr<T> fullCol, FColsptr<T> answer)
+	{
+		auto nrow = this->nrow();
+		for (int i = 0; i < nrow; i++)
+		{
+			answer->at(i) = this->at(i)->timesFullColumn(fullCol);
+		}
+	}
+	template<typename T>
+	inline void FullMatrix<T>::timesFullMatrixInto(FMatsptr<T> fullMat, FMatsptr<T> answer)
+	{
+		assert(answer.get() != this && answer != fullMat);
+		int m = this->nrow();
+		for (int i = 0; i < m; i++) {
+			this->at(i)->timesFullMatrixInto(fullMat, answer->at(i));
+		}
+	}
+	template<typename T>
+	inline void FullMatrix<T>::timesTransposeFullMatrixInto(FMatsptr<T> fullMat, FMatsptr<T> answer)
+	{
+		assert(answer.get() != this && answer != fullMat);
+		int m = this->nrow();
+		for (int i = 0; i < m; i++) {
+			this->at(i)->timesTransposeFullMatrixInto(fullMat, answer->at(i));
+		}
+	}
+	template<typename T>
+	inline void FullMatrix<T>::transposeTimesFullMatrixInto(FMatsptr<T> fullMat, FMatsptr<T> answer)
+	{
+		//"a(k,i)b(k,j) sum k. Same order of operations as transposeTimesFullMatrix."
+		assert(answer.get() != this && answer != fullMat);
+		int m = this->nrow();
+		int nrow = this->ncol();
+		int ncol = fullMat->ncol();
+		for (int i = 0; i < nrow; i++) {
+			auto& answeri = answer->at(i);
+			auto a0i = this->at(0)->at(i);
+			auto& row0 = fullMat->at(0);
+			for (int j = 0; j < ncol; j++) {
+				answeri->at(j) = row0->at(j) * a0i;
+			}
+			for (int k = 1; k < m; k++) {
+				auto aki = this->at(k)->at(i);
+				auto& rowk = fullMat->at(k);
+				for (int j = 0; j < ncol; j++) {
+					answeri->at(j) += rowk->at(j) * aki;
+				}
+			}
+		}
+	}
+	template<typename T>
+	inline void FullMatrix<T>::plusFullMatrixInto(FMatsptr<T> fullMat, FMatsptr<T> answer)
+	{
+		int n = (int)this->size();
+		for (int i = 0; i < n; i++) {
+			this->at(i)->plusFullRowInto(fullMat->at(i), answer->at(i));
+		}
+	}
+	template<typename T>
+	inline void FullMatrix<T>::minusFullMatrixInto(FMatsptr<T> fullMat, FMatsptr<T> answer)
+	{
+		int n = (int)this->size();
+		for (int i = 0; i < n; i++) {
+			this->at(i)->minusFullRowInto(fullMat->at(i), answer->at(i));
+		}
+	}
+	template<typename T>
+	inline void FullMatrix<T>::timesInto(T a, FMatsptr<T> answer)
+	{
+		int n = (int)this->size();
+		for (int i = 0; i < n; i++) {
+			this->at(i)->timesInto(a, answer->at(i));
+		}
+	}
+	template<typename T>
+	inline void FullMatrix<T>::negatedInto(FMatsptr<T> answer)
+	{
+		this->timesInto(-1.0, answer);
+	}
+	template<typename T>
+	inline void FullMatrix<T>::transposeInto(FMatsptr<T> answer)
+	{
+		assert(answer.get() != this);
+		int nrow = this->nrow();
+		auto ncol = this->ncol();
+		for (int i = 0; i < nrow; i++) {
+			auto& row = this->at(i);
+			for (int j = 0; j < ncol; j++) {
+				answer->at(j)->at(i) = row->at(j);
+			}
+		}
+	}
 	template<typename T>
 	inline void FullMatrix<T>::symLowerWithUpper()
 	{
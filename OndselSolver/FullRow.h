@@ -45,6 +45,13 @@ namespace MbD {
 		T timesFullColumn(FullColumn<T>* fullCol);
 		FRowsptr<T> timesFullMatrix(FMatsptr<T> fullMat);
 		FRowsptr<T> timesTransposeFullMatrix(FMatsptr<T> fullMat);
+		void timesInto(T a, FRowsptr<T> answer);
+		void negatedInto(FRowsptr<T> answer);
+		void plusFullRowInto(FRowsptr<T> fullRow, FRowsptr<T> answer);
+		void minusFullRowInto(FRowsptr<T> fullRow, FRowsptr<T> answer);
+		void timesFullMatrixInto(FMatsptr<T> fullMat, FRowsptr<T> answer);
+		void timesTransposeFullMatrixInto(FMatsptr<T> fullMat, FRowsptr<T> answer);
+		void transposeInto(FColsptr<T> answer);
 		void equalSelfPlusFullRowTimes(FRowsptr<T> fullRow, double factor);
 		void equalFullRow(FRowsptr<T> fullRow);
 		FColsptr<T> transpose();
@@ -106,6 +113,7 @@ namespace MbD {
 	template<typename T>
 	inline T FullRow<T>::timesFullColumn(FullColumn<T>* fullCol)
 	{
+		if ((int)this->size() >= VectorKernels::minimumLength) return (T)FullVector<T>::dot(fullCol);
 		auto answer = this->at(0) * fullCol->at(0);
 		for (int i = 1; i < this->size(); i++)
 		{
@@ -174,12 +182,7 @@ namespace MbD {
 	template<typename T>
 	inline double FullRow<T>::dot(std::shared_ptr<FullVector<T>> vec)
 	{
-		int n = (int)this->size();
-		double answer = 0.0;
-		for (int i = 0; i < n; i++) {
-			answer += this->at(i) * vec->at(i);
-		}
-		return answer;
+		return FullVector<T>::dot(vec.get());
 	}
 	template<typename T>
 	inline std::shared_ptr<FullVector<T>> FullRow<T>::dot(std::shared_ptr<std::vector<std::shared_ptr<FullColumn<T>>>> vecvec)
@@ -220,5 +223,73 @@ namespace MbD {
 		return answer;
 			//return FRowsptr<T>();
 	}
+	//"The Into variants write into a caller provided answer of the right size instead of allocating."
+	//"answer may be the receiver or an operand only where the operation is elementwise."
+	template<typename T>
+	inline void FullRow<T>::timesInto(T a, FRowsptr<T> answer)
+	{
+		int n = (int)this->size();
+		for (int i = 0; i < n; i++) {
+			answer->at(i) = this->at(i) * a;
+		}
+	}
+	template<typename T>
+	inline void FullRow<T>::negatedInto(FRowsptr<T> answer)
+	{
+		this->timesInto(-1.0, answer);
+	}
+	template<typename T>
+	inline void FullRow<T>::plusFullRowInto(FRowsptr<T> fullRow, FRowsptr<T> answer)
+	{
+		int n = (int)this->size();
+		for (int i = 0; i < n; i++) {
+			answer->at(i) = this->at(i) + fullRow->at(i);
+		}
+	}
+	template<typename T>
+	inline void FullRow<T>::minusFullRowInto(FRowsptr<T> fullRow, FRowsptr<T> answer)
+	{
+		int n = (int)this->size();
+		for (int i = 0; i < n; i++) {
+			answer->at(i) = this->at(i) - fullRow->at(i);
+		}
+	}
+	template<typename T>
+	inline void FullRow<T>::timesFullMatrixInto(FMatsptr<T> fullMat, FRowsptr<T> answer)
+	{
+		//"Same order of operations as timesFullMatrix."
+		assert(answer.get() != this);
+		int n = (int)this->size();
+		int ncol = fullMat->ncol();
+		auto& row0 = fullMat->at(0);
+		auto a0 = this->at(0);
+		for (int k = 0; k < ncol; k++) {
+			answer->at(k) = row0->at(k) * a0;
+		}
+		for (int j = 1; j < n; j++) {
+			auto& rowj = fullMat->at(j);
+			auto aj = this->at(j);
+			for (int k = 0; k < ncol; k++) {
+				answer->at(k) += rowj->at(k) * aj;
+			}
+		}
+	}
+	template<typename T>
+	inline void FullRow<T>::timesTransposeFullMatrixInto(FMatsptr<T> fullMat, FRowsptr<T> answer)
+	{
+		assert(answer.get() != this);
+		int ncol = fullMat->nrow();
+		for (int k = 0; k < ncol; k++) {
+			answer->at(k) = this->dot(fullMat->at(k));
+		}
+	}
+	template<typename T>
+	inline void FullRow<T>::transposeInto(FColsptr<T> answer)
+	{
+		int n = (int)this->size();
+		for (int i = 0; i < n; i++) {
+			answer->at(i) = this->at(i);
+		}
+	}
 }
 
@@ -12,6 +12,7 @@
 #include <limits>
 
 #include "Array.h"
+#include "VectorKernels.h"
 
 namespace MbD {
 	template<typename T>
@@ -25,6 +26,7 @@ namespace MbD {
 		FullVector(typename std::vector<T>::iterator begin, typename std::vector<T>::iterator end) : Array<T>(begin, end) {}
 		FullVector(std::initializer_list<T> list) : Array<T>{ list } {}
 		double dot(std::shared_ptr<FullVector<T>> vec);
+		double dot(FullVector<T>* vec);
 		void atiplusNumber(int i, T value);
 		void atiminusNumber(int i, T value);
 		double sumOfSquares() override;
@@ -49,6 +51,22 @@ namespace MbD {
 	};
 	template<typename T>
 	inline double FullVector<T>::dot(std::shared_ptr<FullVector<T>> vec)
+	{
+		return this->dot(vec.get());
+	}
+	template<>
+	inline double FullVector<double>::dot(FullVector<double>* vec)
+	{
+		int n = (int)this->size();
+		if (n >= VectorKernels::minimumLength) return VectorKernels::dot(this->data(), vec->data(), n);
+		double answer = 0.0;
+		for (int i = 0; i < n; i++) {
+			answer += this->at(i) * vec->at(i);
+		}
+		return answer;
+	}
+	template<typename T>
+	inline double FullVector<T>::dot(FullVector<T>* vec)
 	{
 		int n = (int)this->size();
 		double answer = 0.0;
@@ -70,6 +88,7 @@ namespace MbD {
 	template<>
 	inline double FullVector<double>::sumOfSquares()
 	{
+		if (this->size() >= VectorKernels::minimumLength) return VectorKernels::sumOfSquares(this->data(), (int)this->size());
 		double sum = 0.0;
 		for (int i = 0; i < this->size(); i++)
 		{
@@ -101,6 +120,20 @@ namespace MbD {
 	{
 		assert(false);
 	}
+	template<>
+	inline void FullVector<double>::atiplusFullVector(int i1, std::shared_ptr<FullVector<double>> fullVec)
+	{
+		auto n = (int)fullVec->size();
+		if (n >= VectorKernels::minimumLength) {
+			assert(i1 + n <= (int)this->size());
+			VectorKernels::plusTimes(this->data() + i1, fullVec->data(), 1.0, n);
+			return;
+		}
+		for (int ii = 0; ii < n; ii++)
+		{
+			this->at(i1 + ii) += fullVec->at(ii);
+		}
+	}
 	template<typename T>
 	inline void FullVector<T>::atiplusFullVector(int i1, std::shared_ptr<FullVector<T>> fullVec)
 	{
@@ -110,6 +143,20 @@ namespace MbD {
 			this->at(i) += fullVec->at(ii);
 		}
 	}
+	template<>
+	inline void FullVector<double>::atiplusFullVectortimes(int i1, std::shared_ptr<FullVector<double>> fullVec, double factor)
+	{
+		auto n = (int)fullVec->size();
+		if (n >= VectorKernels::minimumLength) {
+			assert(i1 + n <= (int)this->size());
+			VectorKernels::plusTimes(this->data() + i1, fullVec->data(), factor, n);
+			return;
+		}
+		for (int ii = 0; ii < n; ii++)
+		{
+			this->at(i1 + ii) += fullVec->at(ii) * factor;
+		}
+	}
 	template<typename T>
 	inline void FullVector<T>::atiplusFullVectortimes(int i1, std::shared_ptr<FullVector<T>> fullVec, T factor)
 	{
@@ -119,6 +166,20 @@ namespace MbD {
 			this->at(i) += fullVec->at(ii) * factor;
 		}
 	}
+	template<>
+	inline void FullVector<double>::equalSelfPlusFullVectortimes(std::shared_ptr<FullVector<double>> fullVec, double factor)
+	{
+		auto n = (int)this->size();
+		if (n >= VectorKernels::minimumLength) {
+			assert(n <= (int)fullVec->size());
+			VectorKernels::plusTimes(this->data(), fullVec->data(), factor, n);
+			return;
+		}
+		for (int i = 0; i < n; i++)
+		{
+			this->atiplusNumber(i, fullVec->at(i) * factor);
+		}
+	}
 	template<typename T>
 	inline void FullVector<T>::equalSelfPlusFullVectortimes(std::shared_ptr<FullVector<T>> fullVec, T factor)
 	{
@@ -130,6 +191,7 @@ namespace MbD {
 	template<>
 	inline double FullVector<double>::maxMagnitude()
 	{
+		if (this->size() >= VectorKernels::minimumLength) return VectorKernels::maxMagnitude(this->data(), (int)this->size());
 		double max = 0.0;
 		for (int i = 0; i < this->size(); i++)
 		{
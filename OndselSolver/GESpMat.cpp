@@ -9,6 +9,7 @@
 #include "GESpMat.h"
 #include "FullColumn.h"
 #include "SparseMatrix.h"
+#include "FillReducingOrdering.h"
 
 using namespace MbD;
 
@@ -20,14 +21,25 @@ FColDsptr GESpMat::solvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol, bo
 
 FColDsptr GESpMat::basicSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol, bool saveOriginal)
 {
+	//"With a fillReducingOrdering, columns are eliminated in its order instead of the natural one."
 	this->preSolvewithsaveOriginal(spMat, fullCol, saveOriginal);
+	if (fillReducingOrdering) {
+		if (!fillReducingOrdering->isValidFor(spMat)) fillReducingOrdering->analyze(spMat);
+		fillReducingOrdering->permuteColumnsOf(matrixA);
+	}
+	int nLower = 0;
 	for (int p = 0; p < m; p++)
 	{
 		this->doPivoting(p);
 		this->forwardEliminateWithPivot(p);
+		nLower += markowitzPivotColCount;
 	}
 	this->backSubstituteIntoDU();
 	this->postSolve();
+	if (fillReducingOrdering) {
+		fillReducingOrdering->actualFillIs(nLower + matrixA->numberOfNonZeros());
+		answerX = fillReducingOrdering->unpermuted(answerX);
+	}
 	return answerX;
 }
 
@@ -49,5 +61,5 @@ void GESpMat::preSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol, bool
 
 double GESpMat::getmatrixArowimaxMagnitude(int i)
 {
-	return matrixA->at(i)->maxMagnitude();
+	return matrixA->maxMagnitudeOfRow(i);
 }
@@ -10,6 +10,7 @@
 
 #include "MatrixGaussElimination.h"
 #include "SparseMatrix.h"
+#include "CompressedSparseMatrix.h"
 
 namespace MbD {
     class GESpMat : public MatrixGaussElimination
@@ -23,7 +24,7 @@ namespace MbD {
         void preSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol, bool saveOriginal) override;
         double getmatrixArowimaxMagnitude(int i) override;
 
-        SpMatDsptr matrixA;
+        CSpMatDsptr matrixA;
         int markowitzPivotRowCount = -1, markowitzPivotColCount = -1;
         std::shared_ptr<std::vector<int>> rowPositionsOfNonZerosInPivotColumn;
     };
@@ -27,18 +27,20 @@ void GESpMatFullPv::doPivoting(int p)
 	{
 		rowPositionsOfNonZerosInColumns->at(colOrder->at(j))->clear();
 	}
+	auto& colIndices = matrixA->colIndices;
+	auto& values = matrixA->values;
 	for (int i = p; i < m; i++)
 	{
-		auto& rowi = matrixA->at(i);
-		for (auto const& kv : *rowi) {
-			rowPositionsOfNonZerosInColumns->at(kv.first)->push_back(i);
-			auto aij = kv.second;
+		for (int k = matrixA->rowBegin(i); k < matrixA->rowEnd(i); k++) {
+			auto j = colIndices[k];
+			rowPositionsOfNonZerosInColumns->at(j)->push_back(i);
+			auto aij = values[k];
 			auto mag = aij;
 			if (mag < 0.0) mag = -mag;
 			if (max < mag) {
 				max = mag;
 				pivotRow = i;
-				pivotCol = positionsOfOriginalCols->at(kv.first);
+				pivotCol = positionsOfOriginalCols->at(j);
 			}
 		}
 	}
@@ -71,31 +73,16 @@ void GESpMatFullPv::forwardEliminateWithPivot(int p)
 	//"rightHandSideB may be multidimensional."
 
 	auto jp = colOrder->at(p);
-	auto& rowp = matrixA->at(p);
-	auto app = rowp->at(jp);
-	auto elementsInPivotRow = std::make_shared<std::vector<const std::pair<const int, double>*>>(rowp->size() - 1);
-	int index = 0;
-	for (auto const& keyValue : *rowp) {
-		if (keyValue.first != jp) {
-			elementsInPivotRow->at(index) = (&keyValue);
-			index++;
-		}
-	}
+	auto app = matrixA->atij(p, jp);
 	auto bp = rightHandSideB->at(p);
 	for (int ii = 0; ii < markowitzPivotColCount; ii++)
 	{
 		auto i = rowPositionsOfNonZerosInPivotColumn->at(ii);
-		auto& spRowi = matrixA->at(i);
-		if (spRowi->find(jp) == spRowi->end()) continue;
-		auto aip = spRowi->at(jp);
-		spRowi->erase(jp);
+		auto k = matrixA->slotAtij(i, jp);
+		if (k < 0) continue;
+		auto aip = matrixA->values[k];
 		auto factor = aip / app;
-		for (auto keyValue : *elementsInPivotRow)
-		{
-			auto j = keyValue->first;
-			auto apj = keyValue->second;
-			(*spRowi)[j] -= factor * apj;
-		}
+		matrixA->eliminateWithPivotRow(i, p, jp, factor, [](int) {});
 		rightHandSideB->at(i) -= bp * factor;
 	}
 }
@@ -116,21 +103,22 @@ void GESpMatFullPv::backSubstituteIntoDU()
 
 	answerX = std::make_shared<FullColumn<double>>(m);
 	auto jn = colOrder->at(n);
-	answerX->at(jn) = rightHandSideB->at(m) / matrixA->at(m)->at(jn);
+	answerX->at(jn) = rightHandSideB->at(m) / matrixA->atij(m, jn);
+	auto& colIndices = matrixA->colIndices;
+	auto& values = matrixA->values;
 	//auto rhsZeroElement = this->rhsZeroElement();
 	for (int i = n - 2; i >= 0; i--)
 	{
-		auto& rowi = matrixA->at((int)i);
 		sum = 0.0; // rhsZeroElement copy.
-		for (auto const& keyValue : *rowi) {
-			auto jj = keyValue.first;
+		for (int k = matrixA->rowBegin(i); k < matrixA->rowEnd(i); k++) {
+			auto jj = colIndices[k];
 			auto j = positionsOfOriginalCols->at(jj);
 			if (j > i) {
-				duij = keyValue.second;
+				duij = values[k];
 				sum += answerX->at(jj) * duij;
 			}
 			else {
-				duii = keyValue.second;
+				duii = values[k];
 			}
 		}
 		auto ji = colOrder->at(i);
@@ -149,7 +137,7 @@ void GESpMatFullPv::preSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol
 	if (m != spMat->nrow() || n != spMat->ncol()) {
 		m = spMat->nrow();
 		n = spMat->ncol();
-		matrixA = std::make_shared<SparseMatrix<double>>(m);
+		matrixA = std::make_shared<CompressedSparseMatrix<double>>(m, n);
 		pivotValues = std::make_shared<FullColumn<double>>(m);
 		rowOrder = std::make_shared<FullColumn<int>>(m);
 		colOrder = std::make_shared<FullRow<int>>(n);
@@ -166,14 +154,14 @@ void GESpMatFullPv::preSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol
 	else {
 		rightHandSideB = fullCol;
 	}
+	matrixA->beginAssembly();
 	for (int i = 0; i < m; i++)
 	{
-		auto& spRowi = spMat->at(i);
-		double maxRowMagnitude = spRowi->maxMagnitude();
+		double maxRowMagnitude = spMat->maxMagnitudeOfRow(i);
 		if (maxRowMagnitude == 0) {
 			throwSingularMatrixError("");
 		}
-		matrixA->at(i) = spRowi->conditionedWithTol(singularPivotTolerance * maxRowMagnitude);
+		matrixA->atiputConditionedRowOf(i, spMat, 1.0, singularPivotTolerance * maxRowMagnitude);
 		rowOrder->at(i) = i;
 		colOrder->at(i) = i;
 		positionsOfOriginalCols->at(i) = i;
@@ -45,18 +45,20 @@ void GESpMatFullPvPosIC::doPivoting(int p)
 			pivotRowLimits->begin(), pivotRowLimits->end(),
 			[&](int limit) { return limit > p; });
 	}
+	auto& colIndices = matrixA->colIndices;
+	auto& values = matrixA->values;
 	for (int i = p; i < pivotRowLimit; i++)
 	{
-		auto& rowi = matrixA->at(i);
-		for (auto const& kv : *rowi) {
-			rowPositionsOfNonZerosInColumns->at(kv.first)->push_back(i);
-			auto aij = kv.second;
+		for (int k = matrixA->rowBegin(i); k < matrixA->rowEnd(i); k++) {
+			auto j = colIndices[k];
+			rowPositionsOfNonZerosInColumns->at(j)->push_back(i);
+			auto aij = values[k];
 			auto mag = aij;
 			if (mag < 0.0) mag = -mag;
 			if (max < mag) {
 				max = mag;
 				pivotRow = i;
-				pivotCol = positionsOfOriginalCols->at(kv.first);
+				pivotCol = positionsOfOriginalCols->at(j);
 			}
 		}
 	}
@@ -90,8 +92,7 @@ void GESpMatFullPvPosIC::doPivoting(int p)
 	rowPositionsOfNonZerosInPivotColumn = rowPositionsOfNonZerosInColumns->at(jp);
 	for (int i = pivotRowLimit; i < m; i++)
 	{
-		auto& spRowi = matrixA->at(i);
-		if (spRowi->find(jp) != spRowi->end()) {
+		if (matrixA->slotAtij(i, jp) >= 0) {
 			rowPositionsOfNonZerosInPivotColumn->push_back(i);
 		}
 	}
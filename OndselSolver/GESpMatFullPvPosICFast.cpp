@@ -0,0 +1,160 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+ 
+#include <algorithm>
+
+#include "GESpMatFullPvPosICFast.h"
+
+using namespace MbD;
+
+void GESpMatFullPvPosICFast::preSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol, bool saveOriginal)
+{
+	//"A row stays in the range of its equation number until it is pivoted."
+	//"Rows are only swapped within pivotRowLimit, which never decreases."
+	GESpMatFullPvPosIC::preSolvewithsaveOriginal(spMat, fullCol, saveOriginal);
+	rowLimits = *pivotRowLimits;
+	if (rowLimits.empty() || rowLimits.back() < m) rowLimits.push_back(m);
+	auto nGroup = (int)rowLimits.size();
+	rowMaxHeaps.resize(nGroup);
+	for (auto& heap : rowMaxHeaps) heap.clear();
+	groupOfEqns.resize(m);
+	stampOfEqns.assign(m, 0);
+	positionOfEqns.resize(m);
+	int group = 0;
+	for (int i = 0; i < m; i++)
+	{
+		while (rowLimits[group] <= i) group++;
+		groupOfEqns[i] = group;
+		positionOfEqns[i] = i;
+	}
+	eqnsInColumns.resize(n);
+	for (auto& eqns : eqnsInColumns) eqns.clear();
+	for (int i = 0; i < m; i++)
+	{
+		for (int k = matrixA->rowBegin(i); k < matrixA->rowEnd(i); k++) {
+			eqnsInColumns[matrixA->colIndices[k]].push_back(i);
+		}
+		this->pushRowMaxAt(i);
+	}
+	if (rowPositionsOfNonZerosInPivotColumn == nullptr) rowPositionsOfNonZerosInPivotColumn = std::make_shared<std::vector<int>>();
+	rowLimitGroup = 0;
+}
+
+void GESpMatFullPvPosICFast::doPivoting(int p)
+{
+	//"Same pivot choice as GESpMatFullPvPosIC: largest magnitude, first row, then first column on ties."
+	if (p >= pivotRowLimit) {
+		while (rowLimits[rowLimitGroup] <= p) rowLimitGroup++;
+		pivotRowLimit = rowLimits[rowLimitGroup];
+	}
+	RowMax rowMax;
+	while (true) {
+		auto max = this->largestRowMaxInto(rowMax) ? rowMax.mag : 0.0;
+		if (max >= singularPivotTolerance) break;
+		if (rowLimitGroup + 1 == (int)rowLimits.size()) {
+			auto begin = rowOrder->begin() + p;
+			auto end = rowOrder->begin() + pivotRowLimit;
+			auto redundantEqnNos = std::make_shared<FullColumn<int>>(begin, end);
+			throwSingularMatrixError("", redundantEqnNos);
+		}
+		rowLimitGroup++;
+		pivotRowLimit = rowLimits[rowLimitGroup];
+	}
+	auto pivotRow = rowMax.position;
+	auto pivotCol = positionsOfOriginalCols->at(rowMax.col);
+	stampOfEqns[rowMax.eqn]++;
+	if (p != pivotRow) {
+		matrixA->swapElems(p, pivotRow);
+		rightHandSideB->swapElems(p, pivotRow);
+		rowOrder->swapElems(p, pivotRow);
+		positionOfEqns[rowOrder->at(p)] = p;
+		positionOfEqns[rowOrder->at(pivotRow)] = pivotRow;
+		this->pushRowMaxAt(pivotRow);
+	}
+	if (p != pivotCol) {
+		colOrder->swapElems(p, pivotCol);
+		positionsOfOriginalCols->at(colOrder->at(p)) = p;
+		positionsOfOriginalCols->at(colOrder->at(pivotCol)) = pivotCol;
+	}
+	pivotValues->at(p) = rowMax.mag;
+	auto jp = colOrder->at(p);
+	rowPositionsOfNonZerosInPivotColumn->clear();
+	for (auto eqn : eqnsInColumns[jp])
+	{
+		auto i = positionOfEqns[eqn];
+		if (i <= p) continue;
+		if (matrixA->slotAtij(i, jp) >= 0) rowPositionsOfNonZerosInPivotColumn->push_back(i);
+	}
+	eqnsInColumns[jp].clear();
+	markowitzPivotColCount = (int)rowPositionsOfNonZerosInPivotColumn->size();
+}
+
+void GESpMatFullPvPosICFast::forwardEliminateWithPivot(int p)
+{
+	//"As GESpMatFullPv but fill-in is recorded in eqnsInColumns and changed rows are measured again."
+	auto jp = colOrder->at(p);
+	auto app = matrixA->atij(p, jp);
+	auto bp = rightHandSideB->at(p);
+	for (int ii = 0; ii < markowitzPivotColCount; ii++)
+	{
+		auto i = rowPositionsOfNonZerosInPivotColumn->at(ii);
+		auto aip = matrixA->atij(i, jp);
+		auto factor = aip / app;
+		auto eqn = rowOrder->at(i);
+		matrixA->eliminateWithPivotRow(i, p, jp, factor, [&](int j) { eqnsInColumns[j].push_back(eqn); });
+		rightHandSideB->at(i) -= bp * factor;
+		this->pushRowMaxAt(i);
+	}
+}
+
+void GESpMatFullPvPosICFast::pushRowMaxAt(int i)
+{
+	//"Earlier entries of the row become stale by the new stamp."
+	auto eqn = rowOrder->at(i);
+	auto stamp = ++stampOfEqns[eqn];
+	double max = 0.0;
+	int col = -1;
+	for (int k = matrixA->rowBegin(i); k < matrixA->rowEnd(i); k++) {
+		auto mag = matrixA->values[k];
+		if (mag < 0.0) mag = -mag;
+		if (max < mag) {
+			max = mag;
+			col = matrixA->colIndices[k];
+		}
+	}
+	if (col < 0) return;
+	auto& heap = rowMaxHeaps[groupOfEqns[eqn]];
+	heap.push_back({ max, i, eqn, stamp, col });
+	std::push_heap(heap.begin(), heap.end(), isSmaller);
+}
+
+bool GESpMatFullPvPosICFast::largestRowMaxInto(RowMax& rowMax)
+{
+	//"Look at the heap tops of the ranges within pivotRowLimit."
+	auto found = false;
+	for (int g = 0; g <= rowLimitGroup; g++)
+	{
+		auto& heap = rowMaxHeaps[g];
+		while (!heap.empty() && heap.front().stamp != stampOfEqns[heap.front().eqn]) {
+			std::pop_heap(heap.begin(), heap.end(), isSmaller);
+			heap.pop_back();
+		}
+		if (heap.empty()) continue;
+		if (!found || isSmaller(rowMax, heap.front())) {
+			rowMax = heap.front();
+			found = true;
+		}
+	}
+	return found;
+}
+
+bool GESpMatFullPvPosICFast::isSmaller(const RowMax& a, const RowMax& b)
+{
+	if (a.mag != b.mag) return a.mag < b.mag;
+	return a.position > b.position;
+}
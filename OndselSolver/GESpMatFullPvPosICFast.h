@@ -0,0 +1,41 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+ 
+#pragma once
+
+#include "GESpMatFullPvPosIC.h"
+
+namespace MbD {
+    struct RowMax {
+        double mag;
+        int position, eqn, stamp, col;
+    };
+
+    class GESpMatFullPvPosICFast : public GESpMatFullPvPosIC
+    {
+        //rowLimits rowMaxHeaps groupOfEqns stampOfEqns positionOfEqns eqnsInColumns 
+        //"Full pivoting over the rows within pivotRowLimit without scanning them at every pivot."
+        //"Each row keeps its largest element in a heap for its pivotRowLimits range."
+        //"Only rows changed by an elimination are measured again, so work follows the nonzeros touched."
+        //"Pivots, and hence redundant equations, are those of GESpMatFullPvPosIC."
+    public:
+        void preSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol, bool saveOriginal) override;
+        void doPivoting(int p) override;
+        void forwardEliminateWithPivot(int p) override;
+        void pushRowMaxAt(int i);
+        bool largestRowMaxInto(RowMax& rowMax);
+        static bool isSmaller(const RowMax& a, const RowMax& b);
+
+        std::vector<int> rowLimits;
+        std::vector<std::vector<RowMax>> rowMaxHeaps;
+        std::vector<int> groupOfEqns, stampOfEqns, positionOfEqns;
+        std::vector<std::vector<int>> eqnsInColumns;
+        int rowLimitGroup = 0;
+    };
+}
+
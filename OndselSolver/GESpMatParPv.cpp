@@ -15,31 +15,16 @@ using namespace MbD;
 void GESpMatParPv::forwardEliminateWithPivot(int p)
 {
 	//"rightHandSideB may be multidimensional."
+	//"Row p is contiguous in matrixA and is merged into each row i below it."
 
-	auto& rowp = matrixA->at(p);
-	auto app = rowp->at(p);
-	auto elementsInPivotRow = std::make_shared<std::vector<const std::pair<const int, double>*>>(rowp->size() - 1);
-	int index = 0;
-	for (auto const& keyValue : *rowp) {
-		if (keyValue.first != p) {
-			elementsInPivotRow->at(index) = (&keyValue);
-			index++;
-		}
-	}
+	auto app = matrixA->atij(p, p);
 	auto bp = rightHandSideB->at(p);
 	for (int ii = 0; ii < markowitzPivotColCount; ii++)
 	{
 		auto i = rowPositionsOfNonZerosInPivotColumn->at(ii);
-		auto& rowi = matrixA->at(i);
-		auto aip = rowi->at(p);
-		rowi->erase(p);
+		auto aip = matrixA->atij(i, p);
 		auto factor = aip / app;
-		for (auto keyValue : *elementsInPivotRow)
-		{
-			auto j = keyValue->first;
-			auto apj = keyValue->second;
-			(*rowi)[j] -= factor * apj;
-		}
+		matrixA->eliminateWithPivotRow(i, p, p, factor, [](int) {});
 		rightHandSideB->at(i) -= bp * factor;
 	}
 }
@@ -52,20 +37,21 @@ void GESpMatParPv::backSubstituteIntoDU()
 	//answerX = rightHandSideB->copyEmpty();
 	assert(m == n);
 	answerX = std::make_shared<FullColumn<double>>(m);
-	answerX->at(n - 1) = rightHandSideB->at(m - 1) / matrixA->at(m - 1)->at(n - 1);
+	answerX->at(n - 1) = rightHandSideB->at(m - 1) / matrixA->atij(m - 1, n - 1);
+	auto& colIndices = matrixA->colIndices;
+	auto& values = matrixA->values;
 	//auto rhsZeroElement = this->rhsZeroElement();
 	for (int i = n - 2; i >= 0; i--)
 	{
-		auto rowi = matrixA->at(i);
 		sum = 0.0; // rhsZeroElement copy.
-		for (auto const& keyValue : *rowi) {
-			auto j = keyValue.first;
+		for (int k = matrixA->rowBegin(i); k < matrixA->rowEnd(i); k++) {
+			auto j = colIndices[k];
 			if (j > i) {
-				duij = keyValue.second;
+				duij = values[k];
 				sum += answerX->at(j) * duij;
 			}
 			else {
-				duii = keyValue.second;
+				duii = values[k];
 			}
 		}
 		answerX->at(i) = (rightHandSideB->at(i) - sum) / duii;
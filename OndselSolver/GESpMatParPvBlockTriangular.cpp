@@ -0,0 +1,336 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "GESpMatParPvBlockTriangular.h"
+#include "GESpMatParPvMarkoFast.h"
+#include "SingularMatrixError.h"
+#include "CREATE.h"
+
+using namespace MbD;
+
+FColDsptr GESpMatParPvBlockTriangular::basicSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol, bool saveOriginal)
+{
+	//"A singular block under an analysis from earlier may be due to a changed pattern, so analyze and try once more."
+	//"Should the pattern still not fit a fresh analysis, the whole matrix is solved instead."
+	hasFactors = false;
+	usesWholeMatrixSolver = false;
+	m = spMat->nrow();
+	n = spMat->ncol();
+	auto& form = *blockTriangularForm;
+	auto isNewAnalysis = false;
+	if (!form.isValidFor(spMat)) {
+		form.analyze(spMat);
+		isNewAnalysis = true;
+	}
+	while (true) {
+		if (form.isStructurallySingular || form.numberOfBlocks() <= 1) return this->solveWholeMatrix(spMat, fullCol, saveOriginal);
+		try {
+			if (this->solveByBlocks(spMat, fullCol)) break;
+			if (isNewAnalysis) return this->solveWholeMatrix(spMat, fullCol, saveOriginal);
+		}
+		catch (const SingularMatrixError&) {
+			if (isNewAnalysis) throw;
+		}
+		form.analyze(spMat);
+		isNewAnalysis = true;
+	}
+	hasFactors = true;
+	return answerX;
+}
+
+bool GESpMatParPvBlockTriangular::solveByBlocks(SpMatDsptr spMat, FColDsptr fullCol)
+{
+	//"Answer false when a row has an entry in a later block. fullCol is not modified."
+	auto& form = *blockTriangularForm;
+	auto nBlock = form.numberOfBlocks();
+	if (nAnalysis != form.nAnalysis) {
+		blockSolvers.assign(nBlock, nullptr);
+		blockMatrices.assign(nBlock, nullptr);
+		blockRightHandSides.assign(nBlock, nullptr);
+		nAnalysis = form.nAnalysis;
+	}
+	denseStarts.assign(nBlock + 1, 0);
+	for (int b = 0; b < nBlock; b++)
+	{
+		auto size = form.blockStarts[b + 1] - form.blockStarts[b];
+		denseStarts[b + 1] = denseStarts[b] + ((size <= denseBlockSizeMax) ? size * size : 0);
+	}
+	denseFactors.assign(denseStarts[nBlock], 0.0);
+	densePivots.assign(n, 0);
+	denseRowScalings.assign(n, 0.0);
+	offStarts.assign(n + 1, 0);
+	offCols.clear();
+	offValues.clear();
+	auto x = std::make_shared<FullColumn<double>>(n);
+	for (int b = 0; b < nBlock; b++)
+	{
+		auto k0 = form.blockStarts[b];
+		auto size = form.blockStarts[b + 1] - k0;
+		auto isDense = size <= denseBlockSizeMax;
+		auto denseBlock = denseFactors.data() + denseStarts[b];
+		auto& blockB = blockRightHandSides[b];
+		if (blockB == nullptr) blockB = std::make_shared<FullColumn<double>>(size);
+		auto& sparseBlock = blockMatrices[b];
+		if (!isDense && sparseBlock == nullptr) {
+			sparseBlock = std::make_shared<SparseMatrix<double>>(size, size);
+		}
+		else if (!isDense) {
+			//"Entries are zeroed in place so that refilling the same pattern allocates nothing."
+			for (auto& row : *sparseBlock) {
+				for (auto& keyValue : *row) keyValue.second = 0.0;
+			}
+		}
+		auto fits = true;
+		for (int ii = 0; ii < size; ii++)
+		{
+			auto i = form.rowOrder[k0 + ii];
+			auto bi = fullCol->at(i);
+			double maxRowMagnitude = 0.0, maxBlockRowMagnitude = 0.0;
+			spMat->rowDo(i, [&](int j, double aij) {
+				auto bj = form.blockOfCol[j];
+				auto mag = std::abs(aij);
+				maxRowMagnitude = std::max(maxRowMagnitude, mag);
+				if (bj > b) {
+					fits = false;
+				}
+				else if (bj < b) {
+					if (aij == 0.0) return;
+					offCols.push_back(j);
+					offValues.push_back(aij);
+					bi -= aij * x->at(j);
+				}
+				else if (isDense) {
+					denseBlock[ii * size + form.colPositions[j] - k0] += aij;
+					maxBlockRowMagnitude = std::max(maxBlockRowMagnitude, mag);
+				}
+				else {
+					sparseBlock->atijplusNumber(ii, form.colPositions[j] - k0, aij);
+					maxBlockRowMagnitude = std::max(maxBlockRowMagnitude, mag);
+				}
+				});
+			if (!fits) return false;
+			//"Pivots are judged against the whole row as in GESpMatParPvMarkoFast. A row that is"
+			//"negligible inside its block would otherwise be scaled up and hide a redundant constraint."
+			if (maxBlockRowMagnitude < singularPivotTolerance * maxRowMagnitude || maxRowMagnitude == 0.0) throwSingularMatrixError("");
+			denseRowScalings[k0 + ii] = 1.0 / maxRowMagnitude;
+			offStarts[k0 + ii + 1] = (int)offCols.size();
+			blockB->at(ii) = bi;
+		}
+		FColDsptr xb;
+		if (isDense) {
+			this->factorDenseBlock(b);
+			this->solveDenseBlock(b, blockB->data());
+			xb = blockB;
+		}
+		else {
+			auto& blockSolver = blockSolvers[b];
+			if (blockSolver == nullptr) {
+				//"Blocks follow wholeMatrixSolver in keeping a pivot sequence and a column pre-ordering."
+				auto sparseSolver = CREATE<GESpMatParPvMarkoFast>::With();
+				auto wholeSparseSolver = std::dynamic_pointer_cast<GESpMatParPvMarkoFast>(wholeMatrixSolver);
+				if (wholeSparseSolver && wholeSparseSolver->symbolicFactorization) {
+					auto& symbolic = form.blockSymbolicFactorizations[b];
+					if (symbolic == nullptr) symbolic = std::make_shared<SymbolicFactorization>();
+					sparseSolver->symbolicFactorization = symbolic;
+				}
+				if (wholeMatrixSolver->fillReducingOrdering) {
+					auto& ordering = form.blockFillReducingOrderings[b];
+					if (ordering == nullptr) ordering = std::make_shared<FillReducingOrdering>();
+					sparseSolver->fillReducingOrdering = ordering;
+				}
+				blockSolver = sparseSolver;
+			}
+			blockSolver->scratchResource = scratchResource;
+			xb = blockSolver->basicSolvewithsaveOriginal(sparseBlock, blockB, false);
+		}
+		for (int jj = 0; jj < size; jj++)
+		{
+			x->at(form.colOrder[k0 + jj]) = xb->at(jj);
+		}
+	}
+	answerX = x;
+	return true;
+}
+
+void GESpMatParPvBlockTriangular::factorDenseBlock(int b)
+{
+	//"In place LU of the block with rows scaled by denseRowScalings. Row p is swapped with row densePivots[p] at step p."
+	auto k0 = blockTriangularForm->blockStarts[b];
+	auto size = blockTriangularForm->blockStarts[b + 1] - k0;
+	auto a = denseFactors.data() + denseStarts[b];
+	auto pivots = densePivots.data() + k0;
+	auto scalings = denseRowScalings.data() + k0;
+	for (int i = 0; i < size; i++)
+	{
+		auto rowi = a + i * size;
+		for (int j = 0; j < size; j++) rowi[j] *= scalings[i];
+	}
+	for (int p = 0; p < size; p++)
+	{
+		auto rowPivot = p;
+		auto max = std::abs(a[p * size + p]);
+		for (int i = p + 1; i < size; i++)
+		{
+			auto mag = std::abs(a[i * size + p]);
+			if (max < mag) {
+				max = mag;
+				rowPivot = i;
+			}
+		}
+		if (max < singularPivotTolerance) throwSingularMatrixError("");
+		pivots[p] = rowPivot;
+		if (rowPivot != p) std::swap_ranges(a + p * size, a + (p + 1) * size, a + rowPivot * size);
+		auto rowp = a + p * size;
+		for (int i = p + 1; i < size; i++)
+		{
+			auto rowi = a + i * size;
+			if (rowi[p] == 0.0) continue;
+			auto factor = rowi[p] / rowp[p];
+			rowi[p] = factor;
+			for (int j = p + 1; j < size; j++) rowi[j] -= factor * rowp[j];
+		}
+	}
+}
+
+void GESpMatParPvBlockTriangular::solveDenseBlock(int b, double* xb)
+{
+	//"xb comes in as the right hand side in block row order and leaves as the answer in block column order."
+	auto k0 = blockTriangularForm->blockStarts[b];
+	auto size = blockTriangularForm->blockStarts[b + 1] - k0;
+	auto a = denseFactors.data() + denseStarts[b];
+	auto pivots = densePivots.data() + k0;
+	auto scalings = denseRowScalings.data() + k0;
+	for (int i = 0; i < size; i++) xb[i] *= scalings[i];
+	for (int p = 0; p < size; p++)
+	{
+		if (pivots[p] != p) std::swap(xb[p], xb[pivots[p]]);
+	}
+	for (int i = 1; i < size; i++)
+	{
+		auto rowi = a + i * size;
+		auto sum = xb[i];
+		for (int j = 0; j < i; j++) sum -= rowi[j] * xb[j];
+		xb[i] = sum;
+	}
+	for (int i = size - 1; i >= 0; i--)
+	{
+		auto rowi = a + i * size;
+		auto sum = xb[i];
+		for (int j = i + 1; j < size; j++) sum -= rowi[j] * xb[j];
+		xb[i] = sum / rowi[i];
+	}
+}
+
+FColDsptr GESpMatParPvBlockTriangular::solveWholeMatrix(SpMatDsptr spMat, FColDsptr fullCol, bool saveOriginal)
+{
+	usesWholeMatrixSolver = true;
+	wholeMatrixSolver->scratchResource = scratchResource;
+	answerX = wholeMatrixSolver->basicSolvewithsaveOriginal(spMat, fullCol, saveOriginal);
+	return answerX;
+}
+
+void GESpMatParPvBlockTriangular::releaseScratch()
+{
+	if (wholeMatrixSolver) wholeMatrixSolver->releaseScratch();
+	for (auto& blockSolver : blockSolvers) {
+		if (blockSolver) blockSolver->releaseScratch();
+	}
+	MatrixSolver::releaseScratch();
+}
+
+bool GESpMatParPvBlockTriangular::hasReusableFactors()
+{
+	if (usesWholeMatrixSolver) return wholeMatrixSolver->hasReusableFactors();
+	if (!hasFactors) return false;
+	for (auto& blockSolver : blockSolvers) {
+		if (blockSolver && !blockSolver->hasReusableFactors()) return false;
+	}
+	return true;
+}
+
+FColDsptr GESpMatParPvBlockTriangular::solveWithFactors(FColDsptr fullCol)
+{
+	//"Same order as solveByBlocks with the entries in earlier blocks as they were kept then."
+	if (usesWholeMatrixSolver) return wholeMatrixSolver->solveWithFactors(fullCol);
+	assert(this->hasReusableFactors());
+	auto& form = *blockTriangularForm;
+	auto x = std::make_shared<FullColumn<double>>(n);
+	for (int b = 0; b < form.numberOfBlocks(); b++)
+	{
+		auto k0 = form.blockStarts[b];
+		auto size = form.blockStarts[b + 1] - k0;
+		auto& blockB = blockRightHandSides[b];
+		for (int ii = 0; ii < size; ii++)
+		{
+			auto k = k0 + ii;
+			auto bi = fullCol->at(form.rowOrder[k]);
+			for (int kk = offStarts[k]; kk < offStarts[k + 1]; kk++) bi -= offValues[kk] * x->at(offCols[kk]);
+			blockB->at(ii) = bi;
+		}
+		auto xb = blockB;
+		if (size <= denseBlockSizeMax) {
+			this->solveDenseBlock(b, blockB->data());
+		}
+		else {
+			xb = blockSolvers[b]->solveWithFactors(blockB);
+		}
+		for (int jj = 0; jj < size; jj++)
+		{
+			x->at(form.colOrder[k0 + jj]) = xb->at(jj);
+		}
+	}
+	answerX = x;
+	return answerX;
+}
+
+FColDsptr GESpMatParPvBlockTriangular::basicSolvewithsaveOriginal(FMatDsptr /*fullMat*/, FColDsptr /*fullCol*/, bool /*saveOriginal*/)
+{
+	assert(false);
+	return FColDsptr();
+}
+
+void GESpMatParPvBlockTriangular::preSolvewithsaveOriginal(SpMatDsptr /*spMat*/, FColDsptr /*fullCol*/, bool /*saveOriginal*/)
+{
+	assert(false);
+}
+
+void GESpMatParPvBlockTriangular::preSolvewithsaveOriginal(FMatDsptr /*fullMat*/, FColDsptr /*fullCol*/, bool /*saveOriginal*/)
+{
+	assert(false);
+}
+
+void GESpMatParPvBlockTriangular::doPivoting(int /*p*/)
+{
+	assert(false);
+}
+
+void GESpMatParPvBlockTriangular::forwardEliminateWithPivot(int /*p*/)
+{
+	assert(false);
+}
+
+void GESpMatParPvBlockTriangular::backSubstituteIntoDU()
+{
+	assert(false);
+}
+
+void GESpMatParPvBlockTriangular::postSolve()
+{
+	assert(false);
+}
+
+double GESpMatParPvBlockTriangular::getmatrixArowimaxMagnitude(int /*i*/)
+{
+	assert(false);
+	return 0.0;
+}
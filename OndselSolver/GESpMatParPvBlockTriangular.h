@@ -0,0 +1,57 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include "MatrixSolver.h"
+#include "BlockTriangularForm.h"
+
+namespace MbD {
+    class GESpMatParPvBlockTriangular : public MatrixSolver
+    {
+        //blockTriangularForm wholeMatrixSolver blockSolvers denseBlockSizeMax denseStarts denseFactors densePivots denseRowScalings
+        //offStarts offCols offValues blockMatrices blockRightHandSides nAnalysis usesWholeMatrixSolver hasFactors
+        //"Solve block by block in the order of blockTriangularForm. Columns of earlier blocks are known by then"
+        //"and move to the right hand side. Each diagonal block is eliminated with row scaling and partial pivoting,"
+        //"densely up to denseBlockSizeMax and by GESpMatParPvMarkoFast above."
+        //"A pattern with one block or none is handed whole to wholeMatrixSolver."
+        //"Entries right of the diagonal blocks mean the pattern has changed. It is analyzed again."
+    public:
+        FColDsptr basicSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol, bool saveOriginal) override;
+        FColDsptr basicSolvewithsaveOriginal(FMatDsptr fullMat, FColDsptr fullCol, bool saveOriginal) override;
+        void preSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol, bool saveOriginal) override;
+        void preSolvewithsaveOriginal(FMatDsptr fullMat, FColDsptr fullCol, bool saveOriginal) override;
+        void doPivoting(int p) override;
+        void forwardEliminateWithPivot(int p) override;
+        void backSubstituteIntoDU() override;
+        void postSolve() override;
+        double getmatrixArowimaxMagnitude(int i) override;
+        bool solveByBlocks(SpMatDsptr spMat, FColDsptr fullCol);
+        void factorDenseBlock(int b);
+        void solveDenseBlock(int b, double* xb);
+        FColDsptr solveWholeMatrix(SpMatDsptr spMat, FColDsptr fullCol, bool saveOriginal);
+        void releaseScratch() override;
+        bool hasReusableFactors() override;
+        FColDsptr solveWithFactors(FColDsptr fullCol) override;
+
+        std::shared_ptr<BlockTriangularForm> blockTriangularForm;
+        std::shared_ptr<MatrixSolver> wholeMatrixSolver;
+        std::vector<std::shared_ptr<MatrixSolver>> blockSolvers;	//Sparse elimination of blocks above denseBlockSizeMax.
+        int denseBlockSizeMax = 32;
+        std::vector<int> denseStarts, densePivots;	//Block b is stored row by row from denseStarts[b]. Its row swaps from blockStarts[b].
+        std::vector<double> denseFactors, denseRowScalings;
+        std::vector<int> offStarts, offCols;	//Entries of row rowOrder[k] in earlier blocks from offStarts[k].
+        std::vector<double> offValues;
+        std::vector<SpMatDsptr> blockMatrices;	//Kept from solve to solve for blocks above denseBlockSizeMax.
+        std::vector<FColDsptr> blockRightHandSides;
+        int nAnalysis = -1;	//Analysis of blockTriangularForm that blockSolvers belong to.
+        bool usesWholeMatrixSolver = false;
+        bool hasFactors = false;
+    };
+}
+
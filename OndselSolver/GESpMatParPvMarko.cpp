@@ -22,38 +22,37 @@ void GESpMatParPvMarko::doPivoting(int p)
 	//| lookForFirstNonZeroInPivotCol i rowi aip criterionMax rowPivoti criterion max |
 	int i, rowPivoti;
 	double aip, mag, max, criterion, criterionMax;
-	SpRowDsptr spRowi;
 	rowPositionsOfNonZerosInPivotColumn->clear();
 	auto lookForFirstNonZeroInPivotCol = true;
 	i = m - 1;
 	while (lookForFirstNonZeroInPivotCol) {
-		spRowi = matrixA->at(i);
-		if (spRowi->find(p) == spRowi->end()) {
+		auto k = matrixA->slotAtij(i, p);
+		if (k < 0) {
 			if (i <= p) throwSingularMatrixError("");
 		}
 		else {
 			markowitzPivotColCount = 0;
-			aip = spRowi->at(p);
+			aip = matrixA->values[k];
 			mag = aip * rowScalings->at(i);
 			if (mag < 0) mag = -mag;
 			max = mag;
-			criterionMax = mag / std::pow(2.0, spRowi->size());
+			criterionMax = mag / std::pow(2.0, matrixA->rowSize(i));
 			rowPivoti = i;
 			lookForFirstNonZeroInPivotCol = false;
 		}
 		i--;
 	}
 	while (i >= p) {
-		spRowi = matrixA->at(i);
-		if (spRowi->find(p) == spRowi->end()) {
+		auto k = matrixA->slotAtij(i, p);
+		if (k < 0) {
 			aip = std::numeric_limits<double>::min();
 		}
 		else {
-			aip = spRowi->at(p);
+			aip = matrixA->values[k];
 			markowitzPivotColCount++;
 			mag = aip * rowScalings->at(i);
 			if (mag < 0) mag = -mag;
-			criterion = mag / std::pow(2.0, spRowi->size());
+			criterion = mag / std::pow(2.0, matrixA->rowSize(i));
 			if (criterion > criterionMax) {
 				max = mag;
 				criterionMax = criterion;
@@ -81,7 +80,7 @@ void GESpMatParPvMarko::preSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr ful
 	if (m != spMat->nrow() || n != spMat->ncol()) {
 		m = spMat->nrow();
 		n = spMat->ncol();
-		matrixA = std::make_shared<SparseMatrix<double>>(m);
+		matrixA = std::make_shared<CompressedSparseMatrix<double>>(m, n);
 		rowScalings = std::make_shared<FullColumn<double>>(m);
 		rowPositionsOfNonZerosInPivotColumn = std::make_shared<std::vector<int>>();
 	}
@@ -91,14 +90,14 @@ void GESpMatParPvMarko::preSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr ful
 	else {
 		rightHandSideB = fullCol;
 	}
+	matrixA->beginAssembly();
 	for (int i = 0; i < m; i++)
 	{
-		auto& spRowi = spMat->at(i);
-		double maxRowMagnitude = spRowi->maxMagnitude();
+		double maxRowMagnitude = spMat->maxMagnitudeOfRow(i);
 		if (maxRowMagnitude == 0) {
 			throwSingularMatrixError("");
 		}
 		rowScalings->atiput(i, 1.0 / maxRowMagnitude);
-		matrixA->atiput(i, spRowi->conditionedWithTol(singularPivotTolerance * maxRowMagnitude));
+		matrixA->atiputConditionedRowOf(i, spMat, 1.0, singularPivotTolerance * maxRowMagnitude);
 	}
 }
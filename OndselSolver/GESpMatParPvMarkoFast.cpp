@@ -14,6 +14,159 @@
 
 using namespace MbD;
 
+FColDsptr GESpMatParPvMarkoFast::basicSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol, bool saveOriginal)
+{
+	//"With a symbolicFactorization, refactor numerically with the recorded pivot sequence."
+	//"Re-pivot fully only when the pattern does not fit or a pivot is too small."
+	hasFactors = false;
+	if (symbolicFactorization == nullptr) return GESpMatParPvMarko::basicSolvewithsaveOriginal(spMat, fullCol, saveOriginal);
+	if (symbolicFactorization->isValidFor(spMat)) {
+		if (this->numericSolvewithsaveOriginal(spMat, fullCol)) {
+			symbolicFactorization->nNumeric++;
+			return answerX;
+		}
+		symbolicFactorization->nFallback++;
+	}
+	GESpMatParPvMarko::basicSolvewithsaveOriginal(spMat, fullCol, saveOriginal);
+	symbolicFactorization->analyze(spMat, rowOrder, fillReducingOrdering);
+	return answerX;
+}
+
+bool GESpMatParPvMarkoFast::numericSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol)
+{
+	//"Row by row elimination into the recorded pattern. Rows are scaled and conditioned as in preSolve."
+	//"Updates to each row are applied in ascending pivot order like forwardEliminateWithPivot."
+	//"Factors are kept so that forAndBackSubsaveOriginal can solve further right hand sides."
+	//"fullCol is not modified."
+	auto& symbolic = *symbolicFactorization;
+	auto mm = symbolic.m;
+	auto nn = symbolic.n;
+	auto& pivotOrder = symbolic.pivotOrder;
+	auto& colPositions = symbolic.colPositions;
+	auto& lowerStarts = symbolic.lowerStarts;
+	auto& lowerCols = symbolic.lowerCols;
+	auto& upperStarts = symbolic.upperStarts;
+	auto& upperCols = symbolic.upperCols;
+	lowerValues.resize(lowerCols.size());
+	upperValues.resize(upperCols.size());
+	diagonal.resize(mm);
+	pivotRowScalings.resize(mm);
+	workRow.assign(nn, 0.0);
+	std::pmr::vector<int> marks(nn, -1, scratchResource);
+	for (int k = 0; k < mm; k++)
+	{
+		for (int kk = lowerStarts[k]; kk < lowerStarts[k + 1]; kk++) marks[lowerCols[kk]] = k;
+		for (int kk = upperStarts[k]; kk < upperStarts[k + 1]; kk++) marks[upperCols[kk]] = k;
+		marks[k] = k;
+		auto i = pivotOrder[k];
+		double maxRowMagnitude = spMat->maxMagnitudeOfRow(i);
+		if (maxRowMagnitude == 0) return false;
+		auto scaling = 1.0 / maxRowMagnitude;
+		auto fits = true;
+		spMat->rowDo(i, [&](int jj, double aij) {
+			auto j = colPositions[jj];
+			auto val = aij * scaling;
+			if (std::abs(val) < singularPivotTolerance) return;
+			if (marks[j] != k) {
+				fits = false;
+				return;
+			}
+			workRow[j] = val;
+			});
+		if (!fits) return false;
+		pivotRowScalings[k] = scaling;
+		for (int kk = lowerStarts[k]; kk < lowerStarts[k + 1]; kk++)
+		{
+			auto p = lowerCols[kk];
+			auto aip = workRow[p];
+			workRow[p] = 0.0;
+			lowerValues[kk] = 0.0;
+			if (aip == 0.0) continue;
+			auto factor = aip / diagonal[p];
+			for (int pp = upperStarts[p]; pp < upperStarts[p + 1]; pp++)
+			{
+				workRow[upperCols[pp]] -= factor * upperValues[pp];
+			}
+			lowerValues[kk] = factor;
+		}
+		auto app = workRow[k];
+		workRow[k] = 0.0;
+		if (std::abs(app) < singularPivotTolerance) return false;
+		diagonal[k] = app;
+		for (int kk = upperStarts[k]; kk < upperStarts[k + 1]; kk++)
+		{
+			auto j = upperCols[kk];
+			upperValues[kk] = workRow[j];
+			workRow[j] = 0.0;
+		}
+	}
+	hasFactors = true;
+	this->forAndBackSubsaveOriginal(fullCol, true);
+	return true;
+}
+
+FColDsptr GESpMatParPvMarkoFast::forAndBackSubsaveOriginal(FColDsptr fullCol, bool saveOriginal)
+{
+	//"Solve with the factors of the last numeric refactorization. fullCol is not modified."
+	assert(hasFactors);
+	auto& symbolic = *symbolicFactorization;
+	auto mm = symbolic.m;
+	auto nn = symbolic.n;
+	auto& pivotOrder = symbolic.pivotOrder;
+	auto& colPositions = symbolic.colPositions;
+	auto& lowerStarts = symbolic.lowerStarts;
+	auto& lowerCols = symbolic.lowerCols;
+	auto& upperStarts = symbolic.upperStarts;
+	auto& upperCols = symbolic.upperCols;
+	auto vectorb = std::make_shared<FullColumn<double>>(mm);
+	for (int k = 0; k < mm; k++)
+	{
+		auto bk = fullCol->at(pivotOrder[k]) * pivotRowScalings[k];
+		for (int kk = lowerStarts[k]; kk < lowerStarts[k + 1]; kk++)
+		{
+			if (lowerValues[kk] == 0.0) continue;
+			bk -= vectorb->at(lowerCols[kk]) * lowerValues[kk];
+		}
+		vectorb->at(k) = bk;
+	}
+	rightHandSideB = vectorb;
+	//"Back substitute in factor columns then map to original columns."
+	//"workRow is free between factorizations and holds the solution in factor columns."
+	auto& z = workRow;
+	z.assign(nn, 0.0);
+	for (int k = mm - 1; k >= 0; k--)
+	{
+		double sum = 0.0;
+		for (int kk = upperStarts[k]; kk < upperStarts[k + 1]; kk++)
+		{
+			sum += z[upperCols[kk]] * upperValues[kk];
+		}
+		z[k] = (vectorb->at(k) - sum) / diagonal[k];
+	}
+	answerX = std::make_shared<FullColumn<double>>(nn);
+	for (int j = 0; j < nn; j++)
+	{
+		answerX->at(j) = z[colPositions[j]];
+	}
+	return answerX;
+}
+
+bool GESpMatParPvMarkoFast::hasReusableFactors()
+{
+	return hasFactors;
+}
+
+bool GESpMatParPvMarkoFast::hasReusableFactorsOfOrder(int order)
+{
+	//"A numeric refactorization leaves m and n as they were at the last full solve. The pattern has the order."
+	return hasFactors && symbolicFactorization->m == order && symbolicFactorization->n == order;
+}
+
+FColDsptr GESpMatParPvMarkoFast::solveWithFactors(FColDsptr fullCol)
+{
+	return this->forAndBackSubsaveOriginal(fullCol, true);
+}
+
 void GESpMatParPvMarkoFast::preSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol, bool saveOriginal)
 {
 	//assert(false);
@@ -21,7 +174,8 @@ void GESpMatParPvMarkoFast::preSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr
 	if (m != spMat->nrow() || n != spMat->ncol()) {
 		m = spMat->nrow();
 		n = spMat->ncol();
-		matrixA = std::make_shared<SparseMatrix<double>>(m);
+		matrixA = std::make_shared<CompressedSparseMatrix<double>>(m, n);
+		rowOrder = std::make_shared<FullColumn<int>>(m);
 		rowPositionsOfNonZerosInPivotColumn = std::make_shared<std::vector<int>>();
 	}
 	if (saveOriginal) {
@@ -30,14 +184,15 @@ void GESpMatParPvMarkoFast::preSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr
 	else {
 		rightHandSideB = fullCol;
 	}
+	matrixA->beginAssembly();
 	for (int i = 0; i < m; i++)
 	{
-		auto& spRowi = spMat->at(i);
-		double maxRowMagnitude = spRowi->maxMagnitude();
+		double maxRowMagnitude = spMat->maxMagnitudeOfRow(i);
 		if (maxRowMagnitude == 0) throwSingularMatrixError("");
 		auto scaling = 1.0 / maxRowMagnitude;
-		matrixA->at(i) = spRowi->timesconditionedWithTol(scaling, singularPivotTolerance);
+		matrixA->atiputConditionedRowOf(i, spMat, scaling, singularPivotTolerance);
 		rightHandSideB->atitimes(i, scaling);
+		rowOrder->at(i) = i;
 	}
 }
 
@@ -53,36 +208,35 @@ void GESpMatParPvMarkoFast::doPivoting(int p)
 	//| lookForFirstNonZeroInPivotCol i rowi aip criterionMax rowPivoti criterion max |
 	int i, rowPivoti;
 	double aip, max, criterion, criterionMax;
-	SpRowDsptr spRowi;
 	rowPositionsOfNonZerosInPivotColumn->clear();
 	auto lookForFirstNonZeroInPivotCol = true;
 	i = m - 1;
 	while (lookForFirstNonZeroInPivotCol) {
-		spRowi = matrixA->at(i);
-		if (spRowi->find(p) == spRowi->end()) {
+		auto k = matrixA->slotAtij(i, p);
+		if (k < 0) {
 			if (i <= p) throwSingularMatrixError("");
 		}
 		else {
 			markowitzPivotColCount = 0;
-			aip = spRowi->at(p);
+			aip = matrixA->values[k];
 			if (aip < 0) aip = -aip;
 			max = aip;
-			criterionMax = aip / std::pow(2.0, spRowi->size());
+			criterionMax = aip / std::pow(2.0, matrixA->rowSize(i));
 			rowPivoti = i;
 			lookForFirstNonZeroInPivotCol = false;
 		}
 		i--;
 	}
 	while (i >= p) {
-		spRowi = matrixA->at(i);
-		if (spRowi->find(p) == spRowi->end()) {
+		auto k = matrixA->slotAtij(i, p);
+		if (k < 0) {
 			aip = std::numeric_limits<double>::min();
 		}
 		else {
-			aip = spRowi->at(p);
+			aip = matrixA->values[k];
 			markowitzPivotColCount++;
 			if (aip < 0) aip = -aip;
-			criterion = aip / std::pow(2.0, spRowi->size());
+			criterion = aip / std::pow(2.0, matrixA->rowSize(i));
 			if (criterion > criterionMax) {
 				max = aip;
 				criterionMax = criterion;
@@ -98,6 +252,7 @@ void GESpMatParPvMarkoFast::doPivoting(int p)
 	if (p != rowPivoti) {
 		matrixA->swapElems(p, rowPivoti);
 		rightHandSideB->swapElems(p, rowPivoti);
+		rowOrder->swapElems(p, rowPivoti);
 		if (aip != std::numeric_limits<double>::min()) rowPositionsOfNonZerosInPivotColumn->at(markowitzPivotColCount - 1) = rowPivoti;
 	}
 	if (max < singularPivotTolerance) throwSingularMatrixError("");
@@ -9,15 +9,25 @@
 #pragma once
 
 #include "GESpMatParPvMarko.h"
+#include "SymbolicFactorization.h"
 
 namespace MbD {
     class GESpMatParPvMarkoFast : public GESpMatParPvMarko
     {
-        //
+        //symbolicFactorization lowerValues upperValues diagonal pivotRowScalings workRow hasFactors 
     public:
+        FColDsptr basicSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol, bool saveOriginal) override;
         void preSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol, bool saveOriginal) override;
         void doPivoting(int p) override;
+        virtual bool numericSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol);
+        FColDsptr forAndBackSubsaveOriginal(FColDsptr fullCol, bool saveOriginal);
+        bool hasReusableFactors() override;
+        bool hasReusableFactorsOfOrder(int order) override;
+        FColDsptr solveWithFactors(FColDsptr fullCol) override;
 
+        std::shared_ptr<SymbolicFactorization> symbolicFactorization;	//Reuse pivot sequence and fill pattern when set.
+        std::vector<double> lowerValues, upperValues, diagonal, pivotRowScalings, workRow;
+        bool hasFactors = false;	//Set when the last solve was a numeric refactorization.
     };
 }
 
@@ -22,18 +22,17 @@ void GESpMatParPvPrecise::doPivoting(int p)
 	//| max rowPivot aip mag lookForFirstNonZeroInPivotCol i |
 	int i, rowPivoti;
 	double aip, mag, max;
-	SpRowDsptr spRowi;
 	rowPositionsOfNonZerosInPivotColumn->clear();
 	auto lookForFirstNonZeroInPivotCol = true;
 	i = m - 1;
 	while (lookForFirstNonZeroInPivotCol) {
-		spRowi = matrixA->at(i);
-		if (spRowi->find(p) == spRowi->end()) {
+		auto k = matrixA->slotAtij(i, p);
+		if (k < 0) {
 			if (i <= p) throwSingularMatrixError("doPivoting");
 		}
 		else {
 			markowitzPivotColCount = 0;
-			aip = spRowi->at(p);
+			aip = matrixA->values[k];
 			mag = aip * rowScalings->at(i);
 			if (mag < 0) mag = -mag;
 			max = mag;
@@ -43,12 +42,12 @@ void GESpMatParPvPrecise::doPivoting(int p)
 		i--;
 	}
 	while (i >= p) {
-		spRowi = matrixA->at(i);
-		if (spRowi->find(p) == spRowi->end()) {
+		auto k = matrixA->slotAtij(i, p);
+		if (k < 0) {
 			aip = std::numeric_limits<double>::min();
 		}
 		else {
-			aip = spRowi->at(p);
+			aip = matrixA->values[k];
 			markowitzPivotColCount++;
 			mag = aip * rowScalings->at(i);
 			if (mag < 0) mag = -mag;
@@ -81,7 +80,7 @@ void GESpMatParPvPrecise::preSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr f
 	if (m != spMat->nrow() || n != spMat->ncol()) {
 		m = spMat->nrow();
 		n = spMat->ncol();
-		matrixA = std::make_shared<SparseMatrix<double>>(m);
+		matrixA = std::make_shared<CompressedSparseMatrix<double>>(m, n);
 		rowScalings = std::make_shared<FullColumn<double>>(m);
 		pivotValues = std::make_shared<FullColumn<double>>(m);
 		rowOrder = std::make_shared<FullColumn<int>>(m);
@@ -93,13 +92,18 @@ void GESpMatParPvPrecise::preSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr f
 	else {
 		rightHandSideB = fullCol;
 	}
+	matrixA->beginAssembly();
 	for (int i = 0; i < m; i++)
 	{
-		auto& spRowi = spMat->at(i);
-		double maxRowMagnitude = spRowi->maxMagnitude();
+		double maxRowMagnitude = spMat->maxMagnitudeOfRow(i);
 		if (maxRowMagnitude == 0) throwSingularMatrixError("preSolvewithsaveOriginal");
 		rowScalings->at(i) = 1.0 / maxRowMagnitude;
-		matrixA->at(i) = spRowi->conditionedWithTol(singularPivotTolerance * maxRowMagnitude);
+		matrixA->atiputConditionedRowOf(i, spMat, 1.0, singularPivotTolerance * maxRowMagnitude);
 		rowOrder->at(i) = i;
 	}
 }
+
+bool GESpMatParPvPrecise::isPrecise()
+{
+	return true;
+}
@@ -17,6 +17,7 @@ namespace MbD {
     public:
         void doPivoting(int p) override;
         void preSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol, bool saveOriginal) override;
+        bool isPrecise() override;
 
     };
 }
@@ -0,0 +1,346 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+ 
+#include <algorithm>
+#include <cassert>
+
+#include "GESpMatParPvSupernodal.h"
+
+using namespace MbD;
+
+bool GESpMatParPvSupernodal::numericSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol)
+{
+	//"For each supernode in order, gather its rows into a dense front over its front columns."
+	//"Each updating supernode contributes a triangular solve for the multipliers and a product scattered into the front."
+	//"The front is then factored densely and its upper rows kept for back substitution."
+	//"Rows are scaled and conditioned as in preSolve. fullCol is not modified."
+	hasFactors = false;
+	auto& symbolic = *symbolicFactorization;
+	if (!symbolic.hasSupernodes) symbolic.findSupernodes();
+	auto mm = symbolic.m;
+	auto nn = symbolic.n;
+	auto& supernodeStarts = symbolic.supernodeStarts;
+	auto& frontStarts = symbolic.frontStarts;
+	auto& frontCols = symbolic.frontCols;
+	auto nSupernode = symbolic.numberOfSupernodes();
+	upperOffsets.resize(nSupernode + 1);
+	upperOffsets[0] = 0;
+	lowerOffsets.resize(nSupernode + 1);
+	lowerOffsets[0] = 0;
+	for (int s = 0; s < nSupernode; s++)
+	{
+		auto begin = frontCols.begin() + frontStarts[s];
+		auto end = frontCols.begin() + frontStarts[s + 1];
+		auto nUpper = (int)(end - std::lower_bound(begin, end, supernodeStarts[s]));
+		auto nLower = (int)(end - begin) - nUpper;
+		auto nrow = supernodeStarts[s + 1] - supernodeStarts[s];
+		upperOffsets[s + 1] = upperOffsets[s] + nrow * nUpper;
+		lowerOffsets[s + 1] = lowerOffsets[s] + nrow * nLower;
+	}
+	upperBlocks.resize(upperOffsets[nSupernode]);
+	lowerBlocks.resize(lowerOffsets[nSupernode]);
+	pivotRowScalings.resize(mm);
+	auto nWorker = workStealingPool ? workStealingPool->numberOfWorkers() : 1;
+	workspaces.resize(nWorker);
+	for (auto& workspace : workspaces) workspace.frontPositions.assign(nn, -1);
+	auto vectorb = std::make_shared<FullColumn<double>>(mm);
+	if (nWorker > 1) {
+		if (!this->factorSupernodesInParallel(spMat, fullCol, vectorb->data())) return false;
+	}
+	else {
+		for (int s = 0; s < nSupernode; s++)
+		{
+			if (!this->factorSupernode(s, spMat, fullCol, vectorb->data(), workspaces[0])) return false;
+		}
+	}
+	this->backSubstituteSupernodes(vectorb);
+	hasFactors = true;
+	return true;
+}
+
+void GESpMatParPvSupernodal::backSubstituteSupernodes(FColDsptr vectorb)
+{
+	//"Back substitute in factor columns then map to original columns."
+	auto& symbolic = *symbolicFactorization;
+	auto nn = symbolic.n;
+	auto& colPositions = symbolic.colPositions;
+	auto& supernodeStarts = symbolic.supernodeStarts;
+	auto& frontStarts = symbolic.frontStarts;
+	auto& frontCols = symbolic.frontCols;
+	auto nSupernode = symbolic.numberOfSupernodes();
+	rightHandSideB = vectorb;
+	workRow.resize(nn);
+	auto& z = workRow;
+	for (int s = nSupernode - 1; s >= 0; s--)
+	{
+		auto k0 = supernodeStarts[s];
+		auto nrow = supernodeStarts[s + 1] - k0;
+		auto nUpper = (upperOffsets[s + 1] - upperOffsets[s]) / nrow;
+		auto colsU = frontCols.data() + frontStarts[s + 1] - nUpper;
+		for (int r = nrow - 1; r >= 0; r--)
+		{
+			auto ur = upperBlocks.data() + upperOffsets[s] + r * nUpper;
+			double sum = 0.0;
+			for (int c = r + 1; c < nUpper; c++)
+			{
+				sum += ur[c] * z[colsU[c]];
+			}
+			z[k0 + r] = (vectorb->at(k0 + r) - sum) / ur[r];
+		}
+	}
+	answerX = std::make_shared<FullColumn<double>>(nn);
+	for (int j = 0; j < nn; j++)
+	{
+		answerX->at(j) = z[colPositions[j]];
+	}
+}
+
+FColDsptr GESpMatParPvSupernodal::solveWithFactors(FColDsptr fullCol)
+{
+	//"Forward elimination of fullCol as factorSupernode does it, with the kept scalings and multipliers."
+	//"fullCol is not modified."
+	assert(hasFactors);
+	auto& symbolic = *symbolicFactorization;
+	auto mm = symbolic.m;
+	auto& pivotOrder = symbolic.pivotOrder;
+	auto& supernodeStarts = symbolic.supernodeStarts;
+	auto& frontStarts = symbolic.frontStarts;
+	auto& frontCols = symbolic.frontCols;
+	auto& updateStarts = symbolic.updateStarts;
+	auto& updateSupernodes = symbolic.updateSupernodes;
+	auto nSupernode = symbolic.numberOfSupernodes();
+	auto vectorb = std::make_shared<FullColumn<double>>(mm);
+	for (int s = 0; s < nSupernode; s++)
+	{
+		auto k0 = supernodeStarts[s];
+		auto nrow = supernodeStarts[s + 1] - k0;
+		auto cols = frontCols.data() + frontStarts[s];
+		auto nUpper = (upperOffsets[s + 1] - upperOffsets[s]) / nrow;
+		auto nLower = (lowerOffsets[s + 1] - lowerOffsets[s]) / nrow;
+		auto b = vectorb->data() + k0;
+		for (int r = 0; r < nrow; r++)
+		{
+			b[r] = fullCol->at(pivotOrder[k0 + r]) * pivotRowScalings[k0 + r];
+		}
+		auto lower = lowerBlocks.data() + lowerOffsets[s];
+		for (int u = updateStarts[s]; u < updateStarts[s + 1]; u++)
+		{
+			auto s1 = updateSupernodes[u];
+			auto j0 = supernodeStarts[s1];
+			auto nJ = supernodeStarts[s1 + 1] - j0;
+			auto position = (int)(std::lower_bound(cols, cols + nLower, j0) - cols);
+			auto bJ = vectorb->data() + j0;
+			for (int r = 0; r < nrow; r++)
+			{
+				auto lr = lower + r * nLower + position;
+				for (int t = 0; t < nJ; t++) b[r] -= lr[t] * bJ[t];
+			}
+		}
+		auto upper = upperBlocks.data() + upperOffsets[s];
+		for (int t = 0; t < nrow; t++)
+		{
+			for (int r = t + 1; r < nrow; r++)
+			{
+				auto factor = upper[r * nUpper + t];
+				if (factor == 0.0) continue;
+				b[r] -= factor * b[t];
+			}
+		}
+	}
+	this->backSubstituteSupernodes(vectorb);
+	return answerX;
+}
+
+bool GESpMatParPvSupernodal::factorSupernode(int s, SpMatDsptr spMat, FColDsptr fullCol, double* vectorb, FrontWorkspace& workspace)
+{
+	//"Reads the upper blocks and right hand sides of the supernodes updating s. Writes only those of s."
+	//"frontPositions is all -1 between calls. After a failure the workspace is reset by numericSolvewithsaveOriginal."
+	auto& symbolic = *symbolicFactorization;
+	auto& pivotOrder = symbolic.pivotOrder;
+	auto& colPositions = symbolic.colPositions;
+	auto& supernodeStarts = symbolic.supernodeStarts;
+	auto& frontStarts = symbolic.frontStarts;
+	auto& frontCols = symbolic.frontCols;
+	auto& updateStarts = symbolic.updateStarts;
+	auto& updateSupernodes = symbolic.updateSupernodes;
+	auto k0 = supernodeStarts[s];
+	auto nrow = supernodeStarts[s + 1] - k0;
+	auto cols = frontCols.data() + frontStarts[s];
+	auto ncol = frontStarts[s + 1] - frontStarts[s];
+	auto nUpper = (upperOffsets[s + 1] - upperOffsets[s]) / nrow;
+	auto nLower = ncol - nUpper;
+	auto& frontPositions = workspace.frontPositions;
+	for (int c = 0; c < ncol; c++) frontPositions[cols[c]] = c;
+	auto& front = workspace.front;
+	auto& products = workspace.products;
+	front.assign(nrow * ncol, 0.0);
+	auto b = vectorb + k0;
+	for (int r = 0; r < nrow; r++)
+	{
+		auto i = pivotOrder[k0 + r];
+		double maxRowMagnitude = spMat->maxMagnitudeOfRow(i);
+		if (maxRowMagnitude == 0) return false;
+		auto scaling = 1.0 / maxRowMagnitude;
+		auto fits = true;
+		auto frontRow = front.data() + r * ncol;
+		spMat->rowDo(i, [&](int jj, double aij) {
+			auto val = aij * scaling;
+			if (std::abs(val) < singularPivotTolerance) return;
+			auto position = frontPositions[colPositions[jj]];
+			if (position < 0) {
+				fits = false;
+				return;
+			}
+			frontRow[position] = val;
+			});
+		if (!fits) return false;
+		b[r] = fullCol->at(i) * scaling;
+		pivotRowScalings[k0 + r] = scaling;
+	}
+	for (int u = updateStarts[s]; u < updateStarts[s + 1]; u++)
+	{
+		auto s1 = updateSupernodes[u];
+		auto j0 = supernodeStarts[s1];
+		auto nJ = supernodeStarts[s1 + 1] - j0;
+		auto nUpperJ = (upperOffsets[s1 + 1] - upperOffsets[s1]) / nJ;
+		auto upperJ = upperBlocks.data() + upperOffsets[s1];
+		auto colsJ = frontCols.data() + frontStarts[s1 + 1] - nUpperJ;
+		auto multipliers = front.data() + frontPositions[j0];
+		solveRightUpperTriangular(multipliers, nrow, ncol, upperJ, nJ, nUpperJ);
+		auto bJ = vectorb + j0;
+		for (int r = 0; r < nrow; r++)
+		{
+			auto lr = multipliers + r * ncol;
+			for (int t = 0; t < nJ; t++) b[r] -= lr[t] * bJ[t];
+		}
+		auto nS = nUpperJ - nJ;
+		if (nS == 0) continue;
+		products.resize(nrow * nS);
+		multiply(multipliers, nrow, nJ, ncol, upperJ + nJ, nS, nUpperJ, products.data());
+		for (int q = 0; q < nS; q++)
+		{
+			auto position = frontPositions[colsJ[nJ + q]];
+			for (int r = 0; r < nrow; r++)
+			{
+				front[r * ncol + position] -= products[r * nS + q];
+			}
+		}
+	}
+	if (!factorInPlace(front.data() + nLower, nrow, nUpper, ncol, b, singularPivotTolerance)) return false;
+	for (int r = 0; r < nrow; r++)
+	{
+		auto frontRow = front.begin() + r * ncol;
+		std::copy(frontRow, frontRow + nLower, lowerBlocks.begin() + lowerOffsets[s] + r * nLower);
+		std::copy(frontRow + nLower, frontRow + ncol, upperBlocks.begin() + upperOffsets[s] + r * nUpper);
+	}
+	for (int c = 0; c < ncol; c++) frontPositions[cols[c]] = -1;
+	return true;
+}
+
+bool GESpMatParPvSupernodal::factorSupernodesInParallel(SpMatDsptr spMat, FColDsptr fullCol, double* vectorb)
+{
+	//"Supernodes without pending updates are submitted. Finishing one releases its dependents on the same worker."
+	auto& symbolic = *symbolicFactorization;
+	auto& updateStarts = symbolic.updateStarts;
+	auto& dependentStarts = symbolic.dependentStarts;
+	auto& dependents = symbolic.dependents;
+	auto nSupernode = symbolic.numberOfSupernodes();
+	auto& pool = *workStealingPool;
+	std::vector<std::atomic<int>> nPendingUpdates(nSupernode);
+	for (int s = 0; s < nSupernode; s++)
+	{
+		nPendingUpdates[s] = updateStarts[s + 1] - updateStarts[s];
+	}
+	std::atomic<bool> hasFailed{ false };
+	std::function<void(int, int)> factorTask = [&](int s, int worker) {
+		if (!hasFailed && !this->factorSupernode(s, spMat, fullCol, vectorb, workspaces[worker])) hasFailed = true;
+		for (int d = dependentStarts[s]; d < dependentStarts[s + 1]; d++)
+		{
+			auto dependent = dependents[d];
+			if (--nPendingUpdates[dependent] == 0) pool.submit(worker, [&, dependent](int w) { factorTask(dependent, w); });
+		}
+		};
+	//"Roots are collected before any is submitted since running tasks release further supernodes."
+	std::vector<int> roots;
+	for (int s = 0; s < nSupernode; s++)
+	{
+		if (nPendingUpdates[s] == 0) roots.push_back(s);
+	}
+	for (auto s : roots)
+	{
+		pool.submit(0, [&, s](int w) { factorTask(s, w); });
+	}
+	pool.wait();
+	return !hasFailed;
+}
+
+void GESpMatParPvSupernodal::solveRightUpperTriangular(double* a, int nrow, int lda, const double* u, int n, int ldu)
+{
+	//"a(nrow x n) := a * inverse(u(n x n)). u is upper triangular with nonzero diagonal."
+	for (int r = 0; r < nrow; r++)
+	{
+		auto ar = a + r * lda;
+		for (int c = 0; c < n; c++)
+		{
+			auto uc = u + c * ldu;
+			auto arc = ar[c] / uc[c];
+			ar[c] = arc;
+			if (arc == 0.0) continue;
+			for (int q = c + 1; q < n; q++)
+			{
+				ar[q] -= arc * uc[q];
+			}
+		}
+	}
+}
+
+void GESpMatParPvSupernodal::multiply(const double* a, int nrow, int k, int lda, const double* b, int n, int ldb, double* c)
+{
+	//"c(nrow x n) := a(nrow x k) * b(k x n). Inner loop runs along contiguous rows of b and c."
+	for (int r = 0; r < nrow; r++)
+	{
+		auto ar = a + r * lda;
+		auto cr = c + r * n;
+		std::fill(cr, cr + n, 0.0);
+		for (int t = 0; t < k; t++)
+		{
+			auto art = ar[t];
+			if (art == 0.0) continue;
+			auto bt = b + t * ldb;
+			for (int q = 0; q < n; q++)
+			{
+				cr[q] += art * bt[q];
+			}
+		}
+	}
+}
+
+bool GESpMatParPvSupernodal::factorInPlace(double* a, int nrow, int ncol, int lda, double* b, double tol)
+{
+	//"Gauss elimination without pivoting of a(nrow x ncol) with the diagonal at a(t, t)."
+	//"The multipliers are left below the diagonal. Answer false when a pivot is smaller than tol."
+	for (int t = 0; t < nrow; t++)
+	{
+		auto at = a + t * lda;
+		auto app = at[t];
+		if (std::abs(app) < tol) return false;
+		for (int r = t + 1; r < nrow; r++)
+		{
+			auto ar = a + r * lda;
+			auto factor = ar[t] / app;
+			ar[t] = factor;
+			if (factor == 0.0) continue;
+			for (int c = t + 1; c < ncol; c++)
+			{
+				ar[c] -= factor * at[c];
+			}
+			b[r] -= factor * b[t];
+		}
+	}
+	return true;
+}
@@ -0,0 +1,45 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+ 
+#pragma once
+
+#include "GESpMatParPvMarkoFast.h"
+#include "WorkStealingPool.h"
+
+namespace MbD {
+    struct FrontWorkspace
+    {
+        std::vector<double> front, products;
+        std::vector<int> frontPositions;
+    };
+
+    class GESpMatParPvSupernodal : public GESpMatParPvMarkoFast
+    {
+        //upperBlocks upperOffsets lowerBlocks lowerOffsets workspaces workStealingPool 
+        //"Pivot sequence and pattern come from a Markowitz factorization as in GESpMatParPvMarkoFast."
+        //"Refactorization is left looking by supernode with dense kernels on each front."
+        //"The multipliers are kept with the upper rows so that solveWithFactors can replay the elimination."
+        //"With a workStealingPool, supernodes whose updating supernodes are done are factored concurrently."
+        //"Each supernode is computed the same way on any worker, so answers do not depend on the number of threads."
+    public:
+        bool numericSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol) override;
+        bool factorSupernode(int s, SpMatDsptr spMat, FColDsptr fullCol, double* vectorb, FrontWorkspace& workspace);
+        bool factorSupernodesInParallel(SpMatDsptr spMat, FColDsptr fullCol, double* vectorb);
+        void backSubstituteSupernodes(FColDsptr vectorb);
+        FColDsptr solveWithFactors(FColDsptr fullCol) override;
+        static void solveRightUpperTriangular(double* a, int nrow, int lda, const double* u, int n, int ldu);
+        static void multiply(const double* a, int nrow, int k, int lda, const double* b, int n, int ldb, double* c);
+        static bool factorInPlace(double* a, int nrow, int ncol, int lda, double* b, double tol);
+
+        std::vector<double> upperBlocks, lowerBlocks;	//Per supernode, its rows right and left of its pivot columns.
+        std::vector<int> upperOffsets, lowerOffsets;
+        std::vector<FrontWorkspace> workspaces;
+        std::shared_ptr<WorkStealingPool> workStealingPool;
+    };
+}
+
@@ -0,0 +1,284 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+ 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <map>
+
+#include "GMRESSpMatILU.h"
+
+using namespace MbD;
+
+FColDsptr GMRESSpMatILU::basicSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol, bool saveOriginal)
+{
+	//"fullCol is not modified so saveOriginal needs no copy."
+	this->preSolvewithsaveOriginal(spMat, fullCol, saveOriginal);
+	this->analyzeILU();
+	this->factorILU();
+	auto& b = *rightHandSideB;
+	double bNorm = 0.0;
+	for (int i = 0; i < n; i++) bNorm += b[i] * b[i];
+	bNorm = std::sqrt(bNorm);
+	answerX = std::make_shared<FullColumn<double>>(n, 0.0);
+	nIterations = 0;
+	if (bNorm == 0.0) return answerX;
+	auto tol = std::max(relativeTolerance, minRelativeTolerance) * bNorm;
+	auto& x = *answerX;
+	std::vector<double> r(n), z(n), w(n), vy(n);
+	std::vector<std::vector<double>> basis(restart + 1, std::vector<double>(n));
+	std::vector<std::vector<double>> hessenberg(restart + 1, std::vector<double>(restart, 0.0));
+	std::vector<double> cs(restart), sn(restart), g(restart + 1), y(restart);
+	r = b;
+	auto beta = bNorm;
+	while (nIterations < iterMax) {
+		auto& v0 = basis[0];
+		for (int i = 0; i < n; i++) v0[i] = r[i] / beta;
+		std::fill(g.begin(), g.end(), 0.0);
+		g[0] = beta;
+		int k = 0;
+		while (k < restart && nIterations < iterMax) {
+			this->precondition(basis[k].data(), z.data());
+			this->multiply(z.data(), w.data());
+			//"Modified Gram-Schmidt."
+			for (int j = 0; j <= k; j++)
+			{
+				auto& vj = basis[j];
+				double hjk = 0.0;
+				for (int i = 0; i < n; i++) hjk += w[i] * vj[i];
+				for (int i = 0; i < n; i++) w[i] -= hjk * vj[i];
+				hessenberg[j][k] = hjk;
+			}
+			double wNorm = 0.0;
+			for (int i = 0; i < n; i++) wNorm += w[i] * w[i];
+			wNorm = std::sqrt(wNorm);
+			hessenberg[k + 1][k] = wNorm;
+			if (wNorm != 0.0) {
+				auto& vk1 = basis[k + 1];
+				for (int i = 0; i < n; i++) vk1[i] = w[i] / wNorm;
+			}
+			//"Givens rotations keep the Hessenberg matrix upper triangular."
+			for (int j = 0; j < k; j++)
+			{
+				auto hj = hessenberg[j][k];
+				auto hj1 = hessenberg[j + 1][k];
+				hessenberg[j][k] = cs[j] * hj + sn[j] * hj1;
+				hessenberg[j + 1][k] = -sn[j] * hj + cs[j] * hj1;
+			}
+			auto hk = hessenberg[k][k];
+			auto hk1 = hessenberg[k + 1][k];
+			auto rho = std::sqrt(hk * hk + hk1 * hk1);
+			if (rho == 0.0) break;
+			cs[k] = hk / rho;
+			sn[k] = hk1 / rho;
+			hessenberg[k][k] = rho;
+			hessenberg[k + 1][k] = 0.0;
+			g[k + 1] = -sn[k] * g[k];
+			g[k] = cs[k] * g[k];
+			k++;
+			nIterations++;
+			if (std::abs(g[k]) <= tol || wNorm == 0.0) break;
+		}
+		if (k == 0) break;
+		for (int j = k - 1; j >= 0; j--)
+		{
+			auto sum = g[j];
+			for (int q = j + 1; q < k; q++) sum -= hessenberg[j][q] * y[q];
+			y[j] = sum / hessenberg[j][j];
+		}
+		std::fill(vy.begin(), vy.end(), 0.0);
+		for (int j = 0; j < k; j++)
+		{
+			auto& vj = basis[j];
+			for (int i = 0; i < n; i++) vy[i] += y[j] * vj[i];
+		}
+		this->precondition(vy.data(), z.data());
+		for (int i = 0; i < n; i++) x[i] += z[i];
+		//"Recompute the true residual at each restart."
+		this->multiply(x.data(), w.data());
+		beta = 0.0;
+		for (int i = 0; i < n; i++)
+		{
+			r[i] = b[i] - w[i];
+			beta += r[i] * r[i];
+		}
+		beta = std::sqrt(beta);
+		if (!(beta < bNorm)) break;	//Diverging, or NaN from a poor preconditioner.
+		if (beta <= tol) return answerX;
+	}
+	throwSingularMatrixError("GMRESSpMatILU");
+	return answerX;
+}
+
+FColDsptr GMRESSpMatILU::basicSolvewithsaveOriginal(FMatDsptr /*fullMat*/, FColDsptr /*fullCol*/, bool /*saveOriginal*/)
+{
+	assert(false);
+	return FColDsptr();
+}
+
+void GMRESSpMatILU::preSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol, bool /*saveOriginal*/)
+{
+	//"Copy spMat row scaled into sorted rows with the diagonal always present."
+	m = spMat->nrow();
+	n = spMat->ncol();
+	assert(m == n);
+	rowStarts.assign(m + 1, 0);
+	colIndices.clear();
+	values.clear();
+	diagonalPositions.resize(m);
+	rightHandSideB = std::make_shared<FullColumn<double>>(m);
+	std::vector<std::pair<int, double>> rowEntries;
+	for (int i = 0; i < m; i++)
+	{
+		double maxRowMagnitude = spMat->maxMagnitudeOfRow(i);
+		if (maxRowMagnitude == 0) throwSingularMatrixError("preSolvewithsaveOriginal");
+		auto scaling = 1.0 / maxRowMagnitude;
+		rowEntries.clear();
+		auto hasDiagonal = false;
+		spMat->rowDo(i, [&](int j, double aij) {
+			if (j == i) hasDiagonal = true;
+			rowEntries.push_back({ j, aij * scaling });
+			});
+		if (!hasDiagonal) rowEntries.push_back({ i, 0.0 });
+		std::sort(rowEntries.begin(), rowEntries.end(),
+			[](const std::pair<int, double>& a, const std::pair<int, double>& b) { return a.first < b.first; });
+		for (auto& entry : rowEntries)
+		{
+			if (entry.first == i) diagonalPositions[i] = (int)colIndices.size();
+			colIndices.push_back(entry.first);
+			values.push_back(entry.second);
+		}
+		rowStarts[i + 1] = (int)colIndices.size();
+		rightHandSideB->at(i) = fullCol->at(i) * scaling;
+	}
+}
+
+void GMRESSpMatILU::preSolvewithsaveOriginal(FMatDsptr /*fullMat*/, FColDsptr /*fullCol*/, bool /*saveOriginal*/)
+{
+	assert(false);
+}
+
+void GMRESSpMatILU::doPivoting(int /*p*/)
+{
+	assert(false);
+}
+
+void GMRESSpMatILU::forwardEliminateWithPivot(int /*p*/)
+{
+	assert(false);
+}
+
+void GMRESSpMatILU::backSubstituteIntoDU()
+{
+	assert(false);
+}
+
+void GMRESSpMatILU::postSolve()
+{
+	assert(false);
+}
+
+double GMRESSpMatILU::getmatrixArowimaxMagnitude(int i)
+{
+	double max = 0.0;
+	for (int k = rowStarts[i]; k < rowStarts[i + 1]; k++)
+	{
+		max = std::max(max, std::abs(values[k]));
+	}
+	return max;
+}
+
+void GMRESSpMatILU::analyzeILU()
+{
+	//"Symbolic ILU(fillLevel). A fill entry has level one more than the sum of the levels that make it."
+	//"Level one fill couples constraints through shared variables, as in their Schur complement."
+	iluRowStarts.assign(m + 1, 0);
+	iluColIndices.clear();
+	iluDiagonalPositions.resize(m);
+	std::vector<int> iluLevels;
+	std::map<int, int> rowLevels;
+	for (int i = 0; i < m; i++)
+	{
+		rowLevels.clear();
+		for (int k = rowStarts[i]; k < rowStarts[i + 1]; k++) rowLevels[colIndices[k]] = 0;
+		for (auto it = rowLevels.begin(); it != rowLevels.end() && it->first < i; ++it)
+		{
+			auto jk = it->first;
+			auto levelik = it->second;
+			for (int kk = iluDiagonalPositions[jk] + 1; kk < iluRowStarts[jk + 1]; kk++)
+			{
+				auto level = levelik + iluLevels[kk] + 1;
+				if (level > fillLevel) continue;
+				auto result = rowLevels.emplace(iluColIndices[kk], level);
+				if (!result.second && level < result.first->second) result.first->second = level;
+			}
+		}
+		for (auto& kv : rowLevels)
+		{
+			if (kv.first == i) iluDiagonalPositions[i] = (int)iluColIndices.size();
+			iluColIndices.push_back(kv.first);
+			iluLevels.push_back(kv.second);
+		}
+		iluRowStarts[i + 1] = (int)iluColIndices.size();
+	}
+}
+
+void GMRESSpMatILU::factorILU()
+{
+	//"Numeric ILU in ikj order. Unit L below the diagonal and U on and above it share iluValues."
+	iluValues.assign(iluColIndices.size(), 0.0);
+	std::vector<int> positions(n, -1);
+	auto shift = std::sqrt(singularPivotTolerance);
+	for (int i = 0; i < m; i++)
+	{
+		for (int k = iluRowStarts[i]; k < iluRowStarts[i + 1]; k++) positions[iluColIndices[k]] = k;
+		for (int k = rowStarts[i]; k < rowStarts[i + 1]; k++) iluValues[positions[colIndices[k]]] = values[k];
+		for (int k = iluRowStarts[i]; k < iluDiagonalPositions[i]; k++)
+		{
+			auto jk = iluColIndices[k];
+			auto lik = iluValues[k] / iluValues[iluDiagonalPositions[jk]];
+			iluValues[k] = lik;
+			if (lik == 0.0) continue;
+			for (int kk = iluDiagonalPositions[jk] + 1; kk < iluRowStarts[jk + 1]; kk++)
+			{
+				auto position = positions[iluColIndices[kk]];
+				if (position >= 0) iluValues[position] -= lik * iluValues[kk];
+			}
+		}
+		auto& uii = iluValues[iluDiagonalPositions[i]];
+		if (std::abs(uii) < shift) uii = uii < 0.0 ? -shift : shift;
+		for (int k = iluRowStarts[i]; k < iluRowStarts[i + 1]; k++) positions[iluColIndices[k]] = -1;
+	}
+}
+
+void GMRESSpMatILU::precondition(const double* v, double* z)
+{
+	//"z := inverse(LU) * v."
+	for (int i = 0; i < m; i++)
+	{
+		auto sum = v[i];
+		for (int k = iluRowStarts[i]; k < iluDiagonalPositions[i]; k++) sum -= iluValues[k] * z[iluColIndices[k]];
+		z[i] = sum;
+	}
+	for (int i = m - 1; i >= 0; i--)
+	{
+		auto sum = z[i];
+		for (int k = iluDiagonalPositions[i] + 1; k < iluRowStarts[i + 1]; k++) sum -= iluValues[k] * z[iluColIndices[k]];
+		z[i] = sum / iluValues[iluDiagonalPositions[i]];
+	}
+}
+
+void GMRESSpMatILU::multiply(const double* v, double* w)
+{
+	for (int i = 0; i < m; i++)
+	{
+		double sum = 0.0;
+		for (int k = rowStarts[i]; k < rowStarts[i + 1]; k++) sum += values[k] * v[colIndices[k]];
+		w[i] = sum;
+	}
+}
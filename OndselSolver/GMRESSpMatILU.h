@@ -0,0 +1,44 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+ 
+#pragma once
+
+#include "MatrixSolver.h"
+
+namespace MbD {
+    class GMRESSpMatILU : public MatrixSolver
+    {
+        //rowStarts colIndices diagonalPositions values iluRowStarts iluColIndices iluDiagonalPositions iluValues fillLevel restart iterMax minRelativeTolerance nIterations 
+        //"Restarted GMRES with an incomplete LU preconditioner applied on the right."
+        //"Rows are scaled to unit maximum. ILU(fillLevel) starts from the pattern of the matrix plus the diagonal."
+        //"Tiny ILU pivots are shifted so saddle point systems with empty constraint diagonals still precondition."
+        //"Iteration stops at relativeTolerance times the norm of the right hand side."
+        //"Failure to converge is reported as a singular matrix so callers fall back to direct elimination."
+    public:
+        FColDsptr basicSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol, bool saveOriginal) override;
+        FColDsptr basicSolvewithsaveOriginal(FMatDsptr fullMat, FColDsptr fullCol, bool saveOriginal) override;
+        void preSolvewithsaveOriginal(SpMatDsptr spMat, FColDsptr fullCol, bool saveOriginal) override;
+        void preSolvewithsaveOriginal(FMatDsptr fullMat, FColDsptr fullCol, bool saveOriginal) override;
+        void doPivoting(int p) override;
+        void forwardEliminateWithPivot(int p) override;
+        void backSubstituteIntoDU() override;
+        void postSolve() override;
+        double getmatrixArowimaxMagnitude(int i) override;
+        void analyzeILU();
+        void factorILU();
+        void precondition(const double* v, double* z);
+        void multiply(const double* v, double* w);
+
+        std::vector<int> rowStarts, colIndices, diagonalPositions;
+        std::vector<int> iluRowStarts, iluColIndices, iluDiagonalPositions;
+        std::vector<double> values, iluValues;
+        int fillLevel = 1, restart = 30, iterMax = 300, nIterations = 0;
+        double minRelativeTolerance = 1.0e-13;
+    };
+}
+
@@ -92,6 +92,12 @@ void Item::calcPostDynCorrectorIteration()
 {
 }
 
+bool Item::needsSecondDerivatives()
+{
+	//"Answer whether calcPostDynCorrectorIteration must update second derivatives wrt q."
+	return true;
+}
+
 void MbD::Item::checkForCollisionDiscontinuityBetweenand(double impulsePrevious, double impulse)
 {
 	assert(false);
@@ -608,6 +614,12 @@ void Item::postPosICIteration()
 	this->calcPostDynCorrectorIteration();
 }
 
+bool Item::hasMoved()
+{
+	//"Answer whether the positions that postPosICIteration depends on may have changed since the last one."
+	return true;
+}
+
 void MbD::Item::postStatic()
 {
 	assert(false);
@@ -86,6 +86,7 @@ namespace MbD {
 		void logString(const char* chars);
 		virtual void logStringwithArgument(const char* chars, const char* chars1);
 		virtual void logStringwithArguments(const char* chars, std::shared_ptr<std::vector<char*>> arrayOfChars);
+		virtual bool needsSecondDerivatives();
 		virtual void normalImpulse(double imp);
 		virtual void postAccIC();
 		virtual void postAccICIteration();
@@ -104,6 +105,7 @@ namespace MbD {
 		virtual void postInput();
 		virtual void postPosIC();
 		virtual void postPosICIteration();
+		virtual bool hasMoved();
 		virtual void postStatic();
 		virtual void postStaticIteration();
 		virtual void postVelIC();
@@ -17,6 +17,7 @@
 #include "CREATE.h"
 #include "RedundantConstraint.h"
 #include "MarkerFrame.h"
+#include "PartFrame.h"
 #include "ForceTorqueData.h"
 #include "System.h"
 
@@ -155,7 +156,19 @@ void Joint::setqsudotlam(FColDsptr col)
 
 void Joint::postPosICIteration()
 {
-	constraintsDo([](std::shared_ptr<Constraint> constraint) { constraint->postPosICIteration(); });
+	constraintsDo([](std::shared_ptr<Constraint> constraint) {
+		constraint->postPosICIteration();
+		constraint->hasChangedLam = false;
+		});
+}
+
+bool Joint::hasMoved()
+{
+	//"Constraints depend only on frmI and frmJ, which move with the parts of their markers."
+	//"Under lam weighted demand a constraint skips its second derivatives while lam is zero, so a new lam needs them too."
+	if (frmI->getMarkerFrame()->getPartFrame()->hasMoved || frmJ->getMarkerFrame()->getPartFrame()->hasMoved) return true;
+	if (this->root()->derivativeDemand != LAMWEIGHTEDSECONDDERIVATIVES) return false;
+	return std::any_of(constraints->begin(), constraints->end(), [](std::shared_ptr<Constraint> constraint) { return constraint->hasChangedLam; });
 }
 
 void Joint::fillPosICError(FColDsptr col)
@@ -62,6 +62,7 @@ namespace MbD {
 		void postInput() override;
 		void postPosIC() override;
 		void postPosICIteration() override;
+		bool hasMoved() override;
 		void preAccIC() override;
 		void preDyn() override;
 		void prePosIC() override;
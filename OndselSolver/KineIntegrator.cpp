@@ -7,10 +7,19 @@
  ***************************************************************************/
  
 #include <string>
+#include <algorithm>
+#include <sstream>
 
 #include "KineIntegrator.h"
 #include "SystemSolver.h"
 #include "Solver.h"
+#include "Part.h"
+#include "EulerParameters.h"
+#include "EulerParametersDot.h"
+#include "SimulationStoppingError.h"
+#include "BasicQuasiIntegrator.h"
+#include "StableBackwardDifference.h"
+#include "CREATE.h"
 
 using namespace MbD;
 
@@ -18,6 +27,8 @@ void KineIntegrator::preRun()
 {
 	system->Solver::logString("MbD: Starting kinematic analysis.");
 	QuasiIntegrator::preRun();
+	history.clear();
+	this->recordHistory();
 }
 
 void KineIntegrator::firstStep()
@@ -37,9 +48,21 @@ void KineIntegrator::nextStep()
 
 void KineIntegrator::runInitialConditionTypeSolution()
 {
-	system->runPosKine();
+	this->predictPositionsAndVelocities();
+	try {
+		system->runPosKine();
+	}
+	catch (SimulationStoppingError ex) {
+		//"Near singular configurations the prediction can overshoot into another assembly."
+		if (predicted.empty()) throw;
+		this->restartFromConverged();
+		system->runPosKine();
+	}
+	this->setPredictedVelocities();
 	system->runVelKine();
 	system->runAccKine();
+	this->recordPredictionErrors();
+	this->recordHistory();
 }
 
 void KineIntegrator::iStep(int i)
@@ -51,3 +74,125 @@ void KineIntegrator::selectOrder()
 {
 	assert(false);
 }
+
+void KineIntegrator::reportStats()
+{
+	if (nPrediction == 0) return;
+	std::stringstream ss;
+	ss << "MbD: Predicted steps = " << nPrediction << ", rejected = " << nPredictionRejected;
+	ss << ", position error max = " << positionPredictionErrorMax << " mean = " << positionPredictionErrorSum / nPrediction;
+	ss << ", velocity error max = " << velocityPredictionErrorMax << " mean = " << velocityPredictionErrorSum / nPrediction << ".";
+	auto str = ss.str();
+	system->logString(str);
+}
+
+void KineIntegrator::predictPositionsAndVelocities()
+{
+	//"Start PosKine from the polynomial through the converged states at the past times of the integrator."
+	//"The polynomial has the order of opBDF, limited by the states recorded so far."
+	//"Velocities are extrapolated through the past velocities the same way."
+	predicted.clear();
+	if (!system->usePredictorKine || history.empty()) return;
+	auto tpast = integrator->tpast;
+	auto npast = std::min((int)history.size(), (int)tpast->size());
+	auto order = std::min(integrator->opBDF->order, npast - 1);
+	if (order == 0) return;
+	if (opPast == nullptr) opPast = CREATE<StableBackwardDifference>::With();
+	opPast->timeNodes = std::make_shared<std::vector<double>>(tpast->begin() + 1, tpast->begin() + 1 + order);
+	opPast->settime(tpast->at(0));
+	opPast->setorder(order);
+	opPast->calcOperatorMatrix();
+	auto t = system->system->mbdTimeValue();
+	auto& present = history.front();
+	for (int i = 0; i < (int)present.size(); i++) {
+		//"qE and -qE are the same orientation. Past qE and qEdot take the sign of the present qE."
+		auto iqE = i - (i % 4) + 1;
+		auto past = std::make_shared<std::vector<FColDsptr>>();
+		for (int k = 1; k <= order; k++) {
+			auto& y = history[k][i];
+			auto flips = (i % 2 == 1) && history[k][iqE]->dot(present[iqE]) < 0.0;
+			past->push_back(flips ? y->negated() : y);
+		}
+		predicted.push_back(opPast->derivativeatpresentpast(0, t, present[i], past));
+	}
+	int i = 0;
+	for (auto& part : *system->parts()) {
+		auto qE = part->qE();
+		part->qX()->equalFullColumnAt(predicted[i], 0);
+		qE->equalFullColumnAt(predicted[i + 1], 0);
+		qE->normalizeSelf();
+		predicted[i + 1]->equalFullColumnAt(qE, 0);
+		i += 4;
+	}
+}
+
+void KineIntegrator::setPredictedVelocities()
+{
+	//"VelKine keeps the start in the free directions of an underconstrained system."
+	if (predicted.empty()) return;
+	int i = 0;
+	for (auto& part : *system->parts()) {
+		part->qXdot()->equalFullColumnAt(predicted[i + 2], 0);
+		part->qEdot()->equalFullColumnAt(predicted[i + 3], 0);
+		i += 4;
+	}
+}
+
+void KineIntegrator::recordPredictionErrors()
+{
+	if (predicted.empty()) return;
+	auto positionError = 0.0;
+	auto velocityError = 0.0;
+	auto positionChange = 0.0;
+	auto& converged = history.front();
+	int i = 0;
+	for (auto& part : *system->parts()) {
+		positionError = std::max(positionError, part->qX()->minusFullColumn(predicted[i])->maxMagnitude());
+		positionError = std::max(positionError, part->qE()->minusFullColumn(predicted[i + 1])->maxMagnitude());
+		velocityError = std::max(velocityError, part->qXdot()->minusFullColumn(predicted[i + 2])->maxMagnitude());
+		velocityError = std::max(velocityError, part->qEdot()->minusFullColumn(predicted[i + 3])->maxMagnitude());
+		positionChange = std::max(positionChange, part->qX()->minusFullColumn(converged[i])->maxMagnitude());
+		positionChange = std::max(positionChange, part->qE()->minusFullColumn(converged[i + 1])->maxMagnitude());
+		i += 4;
+	}
+	//"A step the prediction misses by more than half the step is a jump, e.g. into another assembly."
+	//"The polynomial cannot pass through it. The history restarts after it."
+	if (positionError > 0.5 * positionChange) history.clear();
+	nPrediction++;
+	positionPredictionErrorMax = std::max(positionPredictionErrorMax, positionError);
+	positionPredictionErrorSum += positionError;
+	velocityPredictionErrorMax = std::max(velocityPredictionErrorMax, velocityError);
+	velocityPredictionErrorSum += velocityError;
+	predicted.clear();
+}
+
+void KineIntegrator::recordHistory()
+{
+	//"The newest state goes first as in tpast."
+	if (!system->usePredictorKine) return;
+	std::vector<FColDsptr> state;
+	for (auto& part : *system->parts()) {
+		state.push_back(part->qX()->copy());
+		state.push_back(part->qE()->copy());
+		state.push_back(part->qXdot()->copy());
+		state.push_back(part->qEdot()->copy());
+	}
+	history.insert(history.begin(), state);
+	if ((int)history.size() > (this->orderMax() + 1)) { history.pop_back(); }
+}
+
+void KineIntegrator::restartFromConverged()
+{
+	std::string str = "MbD: Restarting kinematic position from the last converged state.";
+	system->logString(str);
+	auto& converged = history.front();
+	int i = 0;
+	for (auto& part : *system->parts()) {
+		part->qX()->equalFullColumnAt(converged[i], 0);
+		part->qE()->equalFullColumnAt(converged[i + 1], 0);
+		i += 4;
+	}
+	history.resize(1);
+	nPredictionRejected++;
+	predicted.clear();
+}
@@ -9,11 +9,14 @@
 #pragma once
 
 #include "QuasiIntegrator.h"
+#include "FullColumn.h"
 
 namespace MbD {
+    class StableBackwardDifference;
+
     class KineIntegrator : public QuasiIntegrator
     {
-        //
+        //history opPast predicted nPrediction nPredictionRejected positionPredictionErrorMax positionPredictionErrorSum velocityPredictionErrorMax velocityPredictionErrorSum 
     public:
         void preRun() override;
         void firstStep() override;
@@ -22,6 +25,19 @@ namespace MbD {
         void runInitialConditionTypeSolution() override;
         void iStep(int i) override;
         void selectOrder() override;
+        void reportStats() override;
+        void predictPositionsAndVelocities();
+        void setPredictedVelocities();
+        void recordPredictionErrors();
+        void recordHistory();
+        void restartFromConverged();
+
+        std::vector<std::vector<FColDsptr>> history;	//qX qE qXdot qEdot of each part in turn at each time of integrator tpast.
+        std::shared_ptr<StableBackwardDifference> opPast;	//Extrapolates from the latest past time to the present.
+        std::vector<FColDsptr> predicted;	//qX qE qXdot qEdot predicted for each part in turn.
+        int nPrediction = 0, nPredictionRejected = 0;
+        double positionPredictionErrorMax = 0.0, positionPredictionErrorSum = 0.0;
+        double velocityPredictionErrorMax = 0.0, velocityPredictionErrorSum = 0.0;
     };
 }
 
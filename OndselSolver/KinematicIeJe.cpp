@@ -24,6 +24,12 @@ bool MbD::KinematicIeJe::isKineIJ()
     return true;
 }
 
+bool MbD::KinematicIeJe::needsSecondDerivatives()
+{
+    //"A kernel owned by a constraint computes what the constraint needs. Others compute everything."
+    return owner == nullptr || owner->needsSecondDerivatives();
+}
+
 void MbD::KinematicIeJe::calc_pvaluepXI()
 {
     assert(false);
@@ -22,6 +22,7 @@ namespace MbD {
 		KinematicIeJe(EndFrmsptr frmi, EndFrmsptr frmj);
 
 		bool isKineIJ() override;
+		bool needsSecondDerivatives() override;
 		virtual void calc_value();
 		virtual void calc_pvaluepXI();
 		virtual void calc_pvaluepEI();
@@ -36,7 +36,7 @@ FColDsptr LDUSpMat::forAndBackSubsaveOriginal(FColDsptr fullCol, bool saveOrigin
 
 double LDUSpMat::getmatrixArowimaxMagnitude(int i)
 {
-	return matrixA->at(i)->maxMagnitude();
+	return matrixA->maxMagnitudeOfRow(i);
 }
 
 void LDUSpMat::forwardSubstituteIntoL()
@@ -46,11 +46,10 @@ void LDUSpMat::forwardSubstituteIntoL()
 	vectorc->at(0) = rightHandSideB->at(0);
 	for (int i = 1; i < n; i++)
 	{
-		auto rowi = matrixA->at(i);
 		double sum = 0.0;
-		for (auto const& keyValue : *rowi) {
-			int j = keyValue.first;
-			double duij = keyValue.second;
+		for (int k = matrixA->rowBegin(i); k < matrixA->rowEnd(i); k++) {
+			int j = matrixA->colIndices[k];
+			double duij = matrixA->values[k];
 			sum += duij * vectorc->at(j);
 		}
 		vectorc->at(i) = rightHandSideB->at(i) - sum;
@@ -71,11 +70,10 @@ void LDUSpMat::backSubstituteIntoDU()
 	answerX->at(n - 1) = rightHandSideB->at(m - 1);
 	for (int i = n - 2; i >= 0; i--)
 	{
-		auto rowi = matrixU->at(i);
 		sum = 0.0;
-		for (auto const& keyValue : *rowi) {
-			auto j = keyValue.first;
-			duij = keyValue.second;
+		for (int k = matrixU->rowBegin(i); k < matrixU->rowEnd(i); k++) {
+			auto j = matrixU->colIndices[k];
+			duij = matrixU->values[k];
 			sum += answerX->at(j) * duij;
 		}
 		answerX->at(i) = rightHandSideB->at(i) - sum;
@@ -10,6 +10,7 @@
 
 #include "MatrixLDU.h"
 #include "SparseMatrix.h"
+#include "CompressedSparseMatrix.h"
 
 namespace MbD {
     class LDUSpMat : public MatrixLDU
@@ -24,7 +25,7 @@ namespace MbD {
         void forwardSubstituteIntoL() override;
         void backSubstituteIntoDU() override;
 
-        SpMatDsptr matrixA, matrixL, matrixU;
+        CSpMatDsptr matrixA, matrixL, matrixU;
         DiagMatDsptr matrixD;
         int markowitzPivotRowCount, markowitzPivotColCount;
         std::shared_ptr<std::vector<int>> rowPositionsOfNonZerosInPivotColumn;
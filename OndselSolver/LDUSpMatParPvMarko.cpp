@@ -20,38 +20,37 @@ void LDUSpMatParPvMarko::doPivoting(int p)
 	//| lookForFirstNonZeroInPivotCol i rowi aip criterionMax rowPivoti criterion max |
 	int i, rowPivoti;
 	double aip, mag, max, criterion, criterionMax;
-	SpRowDsptr spRowi;
 	rowPositionsOfNonZerosInPivotColumn->clear();
 	auto lookForFirstNonZeroInPivotCol = true;
 	i = m - 1;
 	while (lookForFirstNonZeroInPivotCol) {
-		spRowi = matrixA->at(i);
-		if (spRowi->find(p) == spRowi->end()) {
+		auto k = matrixA->slotAtij(i, p);
+		if (k < 0) {
 			if (i <= p) throwSingularMatrixError("");
 		}
 		else {
 			markowitzPivotColCount = 0;
-			aip = spRowi->at(p);
+			aip = matrixA->values[k];
 			mag = aip * rowScalings->at(i);
 			if (mag < 0) mag = -mag;
 			max = mag;
-			criterionMax = mag / std::pow(2.0, spRowi->size());
+			criterionMax = mag / std::pow(2.0, matrixA->rowSize(i));
 			rowPivoti = i;
 			lookForFirstNonZeroInPivotCol = false;
 		}
 		i--;
 	}
 	while (i >= p) {
-		spRowi = matrixA->at(i);
-		if (spRowi->find(p) == spRowi->end()) {
+		auto k = matrixA->slotAtij(i, p);
+		if (k < 0) {
 			aip = std::numeric_limits<double>::min();
 		}
 		else {
-			aip = spRowi->at(p);
+			aip = matrixA->values[k];
 			markowitzPivotColCount++;
 			mag = aip * rowScalings->at(i);
 			if (mag < 0) mag = -mag;
-			criterion = mag / std::pow(2.0, spRowi->size());
+			criterion = mag / std::pow(2.0, matrixA->rowSize(i));
 			if (criterion > criterionMax) {
 				max = mag;
 				criterionMax = criterion;
@@ -20,18 +20,17 @@ void LDUSpMatParPvPrecise::doPivoting(int p)
 	//| max rowPivot aip mag lookForFirstNonZeroInPivotCol i |
 	int i, rowPivoti;
 	double aip, mag, max;
-	SpRowDsptr spRowi;
 	rowPositionsOfNonZerosInPivotColumn->clear();
 	auto lookForFirstNonZeroInPivotCol = true;
 	i = m - 1;
 	while (lookForFirstNonZeroInPivotCol) {
-		spRowi = matrixA->at(i);
-		if (spRowi->find(p) == spRowi->end()) {
+		auto k = matrixA->slotAtij(i, p);
+		if (k < 0) {
 			if (i <= p) throwSingularMatrixError("");
 		}
 		else {
 			markowitzPivotColCount = 0;
-			aip = spRowi->at(p);
+			aip = matrixA->values[k];
 			mag = aip * rowScalings->at(i);
 			if (mag < 0) mag = -mag;
 			max = mag;
@@ -41,12 +40,12 @@ void LDUSpMatParPvPrecise::doPivoting(int p)
 		i--;
 	}
 	while (i >= p) {
-		spRowi = matrixA->at(i);
-		if (spRowi->find(p) == spRowi->end()) {
+		auto k = matrixA->slotAtij(i, p);
+		if (k < 0) {
 			aip = std::numeric_limits<double>::min();
 		}
 		else {
-			aip = spRowi->at(p);
+			aip = matrixA->values[k];
 			markowitzPivotColCount++;
 			mag = aip * rowScalings->at(i);
 			if (mag < 0) mag = -mag;
@@ -0,0 +1,181 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include "FullMatrix.h"
+
+namespace MbD {
+	//"Lazy matrix expressions over FullMatrix<double>."
+	//"lazy(aB).timesTransposeFullMatrix(lazy(aC)).times(2.0).into(aAdot) computes each element of 2*aB*aC^T in one pass."
+	//"Nothing is allocated until evaluate. Operands are held by reference and must outlive the expression."
+	//"Elements of nested products are recomputed where used. Meant for the 3 and 4 sized frame matrices."
+
+	template<typename E, typename F>
+	class LazyProduct;
+	template<typename E, typename F>
+	class LazySum;
+	template<typename E>
+	class LazyTranspose;
+	template<typename E>
+	class LazyScaled;
+
+	template<typename Derived>
+	class LazyMatrix
+	{
+	public:
+		const Derived& derived() const { return static_cast<const Derived&>(*this); }
+		template<typename F>
+		LazyProduct<Derived, F> timesFullMatrix(const LazyMatrix<F>& other) const;
+		template<typename F>
+		LazyProduct<Derived, LazyTranspose<F>> timesTransposeFullMatrix(const LazyMatrix<F>& other) const;
+		template<typename F>
+		LazyProduct<LazyTranspose<Derived>, F> transposeTimesFullMatrix(const LazyMatrix<F>& other) const;
+		template<typename F>
+		LazySum<Derived, F> plusFullMatrix(const LazyMatrix<F>& other) const;
+		LazyTranspose<Derived> transpose() const;
+		LazyScaled<Derived> times(double a) const;
+		void into(FMatDsptr answer) const;
+		FMatDsptr evaluate() const;
+	};
+
+	class LazyFullMatrix : public LazyMatrix<LazyFullMatrix>
+	{
+		//fullMat
+	public:
+		LazyFullMatrix(const FullMatrix<double>& mat) : fullMat(mat) {}
+		int nrow() const { return (int)fullMat.size(); }
+		int ncol() const { return (int)fullMat.front()->size(); }
+		double at(int i, int j) const { return fullMat[i]->at(j); }
+
+		const FullMatrix<double>& fullMat;
+	};
+
+	template<typename E, typename F>
+	class LazyProduct : public LazyMatrix<LazyProduct<E, F>>
+	{
+		//left right
+	public:
+		LazyProduct(const E& e, const F& f) : left(e), right(f) {}
+		int nrow() const { return left.nrow(); }
+		int ncol() const { return right.ncol(); }
+		double at(int i, int j) const {
+			auto answer = left.at(i, 0) * right.at(0, j);
+			auto n = left.ncol();
+			for (int k = 1; k < n; k++) answer += left.at(i, k) * right.at(k, j);
+			return answer;
+		}
+
+		E left;
+		F right;
+	};
+
+	template<typename E, typename F>
+	class LazySum : public LazyMatrix<LazySum<E, F>>
+	{
+		//left right
+	public:
+		LazySum(const E& e, const F& f) : left(e), right(f) {}
+		int nrow() const { return left.nrow(); }
+		int ncol() const { return left.ncol(); }
+		double at(int i, int j) const { return left.at(i, j) + right.at(i, j); }
+
+		E left;
+		F right;
+	};
+
+	template<typename E>
+	class LazyTranspose : public LazyMatrix<LazyTranspose<E>>
+	{
+		//expression
+	public:
+		LazyTranspose(const E& e) : expression(e) {}
+		int nrow() const { return expression.ncol(); }
+		int ncol() const { return expression.nrow(); }
+		double at(int i, int j) const { return expression.at(j, i); }
+
+		E expression;
+	};
+
+	template<typename E>
+	class LazyScaled : public LazyMatrix<LazyScaled<E>>
+	{
+		//factor expression
+	public:
+		LazyScaled(double a, const E& e) : factor(a), expression(e) {}
+		int nrow() const { return expression.nrow(); }
+		int ncol() const { return expression.ncol(); }
+		double at(int i, int j) const { return expression.at(i, j) * factor; }
+
+		double factor;
+		E expression;
+	};
+
+	inline LazyFullMatrix lazy(const FMatDsptr& fullMat)
+	{
+		return LazyFullMatrix(*fullMat);
+	}
+	template<typename Derived>
+	template<typename F>
+	inline LazyProduct<Derived, F> LazyMatrix<Derived>::timesFullMatrix(const LazyMatrix<F>& other) const
+	{
+		return LazyProduct<Derived, F>(this->derived(), other.derived());
+	}
+	template<typename Derived>
+	template<typename F>
+	inline LazyProduct<Derived, LazyTranspose<F>> LazyMatrix<Derived>::timesTransposeFullMatrix(const LazyMatrix<F>& other) const
+	{
+		return LazyProduct<Derived, LazyTranspose<F>>(this->derived(), LazyTranspose<F>(other.derived()));
+	}
+	template<typename Derived>
+	template<typename F>
+	inline LazyProduct<LazyTranspose<Derived>, F> LazyMatrix<Derived>::transposeTimesFullMatrix(const LazyMatrix<F>& other) const
+	{
+		return LazyProduct<LazyTranspose<Derived>, F>(LazyTranspose<Derived>(this->derived()), other.derived());
+	}
+	template<typename Derived>
+	template<typename F>
+	inline LazySum<Derived, F> LazyMatrix<Derived>::plusFullMatrix(const LazyMatrix<F>& other) const
+	{
+		return LazySum<Derived, F>(this->derived(), other.derived());
+	}
+	template<typename Derived>
+	inline LazyTranspose<Derived> LazyMatrix<Derived>::transpose() const
+	{
+		return LazyTranspose<Derived>(this->derived());
+	}
+	template<typename Derived>
+	inline LazyScaled<Derived> LazyMatrix<Derived>::times(double a) const
+	{
+		return LazyScaled<Derived>(a, this->derived());
+	}
+	template<typename Derived>
+	inline void LazyMatrix<Derived>::into(FMatDsptr answer) const
+	{
+		//"answer must not be an operand of a product or transpose."
+		auto& expression = this->derived();
+		auto m = expression.nrow();
+		auto n = expression.ncol();
+		for (int i = 0; i < m; i++) {
+			auto& answeri = answer->at(i);
+			for (int j = 0; j < n; j++) {
+				answeri->at(j) = expression.at(i, j);
+			}
+		}
+	}
+	template<typename Derived>
+	inline FMatDsptr LazyMatrix<Derived>::evaluate() const
+	{
+		auto& expression = this->derived();
+		auto answer = std::make_shared<FullMatrix<double>>(expression.nrow(), expression.ncol());
+		this->into(answer);
+		return answer;
+	}
+}
@@ -13,6 +13,7 @@
 #include "EndFramec.h"
 #include "EndFrameqc.h"
 #include "EulerParameters.h"
+#include "FixedMatrix.h"
 #include "CREATE.h"
 
 using namespace MbD;
@@ -33,6 +34,10 @@ void MarkerFrame::initialize()
 {
 	prOmOpE = std::make_shared<FullMatrix<double>>(3, 4);
 	pAOmpE = std::make_shared<FullColumn<FMatDsptr>>(4);
+	for (int i = 0; i < 4; i++)
+	{
+		pAOmpE->at(i) = std::make_shared<FullMatrix<double>>(3, 3);
+	}
 	endFrames = std::make_shared<std::vector<EndFrmsptr>>();
 	auto endFrm = CREATE<EndFrameqc>::With();
 	this->addEndFrame(endFrm);
@@ -67,16 +72,20 @@ void MarkerFrame::postInput()
 
 void MarkerFrame::calcPostDynCorrectorIteration()
 {
-	auto rOpO = partFrame->rOpO();
-	auto aAOp = partFrame->aAOp();
-	rOmO = rOpO->plusFullColumn(aAOp->timesFullColumn(rpmp));
-	aAOm = aAOp->timesFullMatrix(aApm);
+	auto rOpO = Vec3::fromFullColumn(partFrame->rOpO());
+	auto aAOp = Mat3::fromFullMatrix(partFrame->aAOp());
+	auto rpmpF = Vec3::fromFullColumn(rpmp);
+	auto aApmF = Mat3::fromFullMatrix(aApm);
+	//"rOmO, aAOm and pAOmpE are filled in place. End frames hold them."
+	rOpO.plusFixedColumn(aAOp.timesFixedColumn(rpmpF)).copyInto(rOmO);
+	aAOp.timesFixedMatrix(aApmF).copyInto(aAOm);
 	auto pAOppE = partFrame->pAOppE();
 	for (int i = 0; i < 4; i++)
 	{
-		auto& pAOppEi = pAOppE->at(i);
-		prOmOpE->atijputFullColumn(0, i, pAOppEi->timesFullColumn(rpmp));
-		pAOmpE->at(i) = pAOppEi->timesFullMatrix(aApm);
+		auto pAOppEi = Mat3::fromFullMatrix(pAOppE->at(i));
+		auto prOmOpEi = pAOppEi.timesFixedColumn(rpmpF);
+		for (int k = 0; k < 3; k++) prOmOpE->at(k)->at(i) = prOmOpEi.at(k);
+		pAOppEi.timesFixedMatrix(aApmF).copyInto(pAOmpE->at(i));
 	}
 }
 
@@ -247,6 +256,25 @@ void MarkerFrame::setaApm(FMatDsptr mat)
 {
 	aApm->copyFrom(mat);
 }
+
+void MarkerFrame::setPartFramerpmpaApm(PartFrame* partFrm, FColDsptr x, FMatDsptr mat)
+{
+	//"Move onto another part frame after initializeLocally."
+	//"End frames keep pprOmOpEpE and ppAOmpEpE from initializeGlobally, so those are updated in place."
+	partFrame = partFrm;
+	rpmp = x;
+	aApm = mat;
+	auto pprOmOpEpENew = EulerParameters<double>::ppApEpEtimesColumn(rpmp);
+	auto ppAOmpEpENew = EulerParameters<double>::ppApEpEtimesMatrix(aApm);
+	for (int i = 0; i < 4; i++)
+	{
+		for (int j = 0; j < 4; j++)
+		{
+			pprOmOpEpE->at(i)->at(j)->copyFrom(pprOmOpEpENew->at(i)->at(j));
+			ppAOmpEpE->at(i)->at(j)->copyFrom(ppAOmpEpENew->at(i)->at(j));
+		}
+	}
+}
 void MarkerFrame::addEndFrame(EndFrmsptr endFrm)
 {
 	endFrm->setMarkerFrame(this);
@@ -35,6 +35,7 @@ namespace MbD {
 		PartFrame* getPartFrame();
 		void setrpmp(FColDsptr x);
 		void setaApm(FMatDsptr mat);
+		void setPartFramerpmpaApm(PartFrame* partFrm, FColDsptr x, FMatDsptr mat);
 		void addEndFrame(EndFrmsptr x);
 		void initializeLocally() override;
 		void initializeGlobally() override;
@@ -10,6 +10,7 @@
 #include <limits>
 #include <memory>
 #include <chrono>
+#include <cassert>
 
 #include "MatrixSolver.h"
 #include "SparseMatrix.h"
@@ -79,3 +80,33 @@ void MatrixSolver::throwSingularMatrixError(const char* chars, std::shared_ptr<F
 {
 	throw SingularMatrixError(chars, redunEqnNos);
 }
+
+void MatrixSolver::releaseScratch()
+{
+	//"Drop everything allocated from scratchResource so its owner can reset it."
+	scratchResource = std::pmr::get_default_resource();
+}
+
+bool MatrixSolver::hasReusableFactors()
+{
+	//"Solvers that keep the factors of their last matrix answer true and implement solveWithFactors."
+	return false;
+}
+
+bool MatrixSolver::hasReusableFactorsOfOrder(int order)
+{
+	//"Factors handed from one solve to another must be of a matrix of the same order."
+	return this->hasReusableFactors() && n == order;
+}
+
+FColDsptr MatrixSolver::solveWithFactors(FColDsptr /*fullCol*/)
+{
+	assert(false);
+	return FColDsptr();
+}
+
+bool MatrixSolver::isPrecise()
+{
+	//"A singular matrix from a solver that is not precise is solved again by GESpMatParPvPrecise before it is believed."
+	return false;
+}
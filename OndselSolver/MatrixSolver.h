@@ -8,6 +8,8 @@
  
 #pragma once
 
+#include <memory_resource>
+
 #include "Solver.h"
 #include "RowTypeMatrix.h"
 #include "FullMatrix.h"
@@ -15,9 +17,11 @@
 #include "SparseMatrix.h"
 
 namespace MbD {
+    class FillReducingOrdering;
+
     class MatrixSolver : public Solver
     {
-        //m n matrixA answerX rightHandSideB rowOrder colOrder rowScalings pivotValues singularPivotTolerance millisecondsToRun 
+        //m n matrixA answerX rightHandSideB rowOrder colOrder rowScalings pivotValues singularPivotTolerance millisecondsToRun fillReducingOrdering relativeTolerance scratchResource 
     public:
         MatrixSolver(){}
         virtual ~MatrixSolver() {}
@@ -40,12 +44,20 @@ namespace MbD {
         virtual double getmatrixArowimaxMagnitude(int i) = 0;
         void throwSingularMatrixError(const char* chars);
         void throwSingularMatrixError(const char* chars, std::shared_ptr<FullColumn<int>> redunEqnNos);
+        virtual void releaseScratch();
+        virtual bool hasReusableFactors();
+        virtual bool hasReusableFactorsOfOrder(int order);
+        virtual FColDsptr solveWithFactors(FColDsptr fullCol);
+        virtual bool isPrecise();
 
         int m = 0, n = 0;
         FColDsptr answerX, rightHandSideB, rowScalings, pivotValues;
         std::shared_ptr<FullColumn<int>> rowOrder;
         std::shared_ptr<FullRow<int>> colOrder;
         double singularPivotTolerance = 0, millisecondsToRun = 0;
+        std::shared_ptr<FillReducingOrdering> fillReducingOrdering;	//Column pre-ordering for sparse elimination when set.
+        double relativeTolerance = 0.0;	//Residual reduction asked of iterative solvers. Direct solvers ignore it.
+        std::pmr::memory_resource* scratchResource = std::pmr::get_default_resource();	//Working rows and vectors of a solve. See releaseScratch.
     };
 }
 
@@ -0,0 +1,61 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+ 
+#include "MemoryArena.h"
+
+using namespace MbD;
+
+MemoryArena::MemoryArena() : buffer(64 * 1024)
+{
+	newMonotonic();
+}
+
+std::pmr::memory_resource* MemoryArena::resource()
+{
+	return monotonic.get();
+}
+
+void MemoryArena::reset()
+{
+	if (overflow.bytesAllocated == 0) {
+		monotonic->release();
+		return;
+	}
+	//"Destroy the monotonic resource first. It returns the overflow blocks upstream."
+	auto highWater = buffer.size() + overflow.bytesAllocated;
+	monotonic.reset();
+	overflow.bytesAllocated = 0;
+	buffer.assign(highWater + highWater / 4, std::byte(0));
+	newMonotonic();
+}
+
+size_t MemoryArena::capacity()
+{
+	return buffer.size();
+}
+
+void MemoryArena::newMonotonic()
+{
+	monotonic = std::make_unique<std::pmr::monotonic_buffer_resource>(buffer.data(), buffer.size(), &overflow);
+}
+
+void* MemoryArena::CountingResource::do_allocate(size_t bytes, size_t alignment)
+{
+	bytesAllocated += bytes;
+	return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void MemoryArena::CountingResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+	std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+bool MemoryArena::CountingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+	return this == &other;
+}
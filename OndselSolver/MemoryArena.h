@@ -0,0 +1,48 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+ 
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace MbD {
+    class MemoryArena
+    {
+        //buffer overflow monotonic 
+        //"Monotonic scratch memory for the temporaries of one Newton iteration."
+        //"Allocation bumps a pointer and deallocation does nothing. reset makes the whole buffer free again."
+        //"Anything allocated from resource must be destroyed before reset."
+        //"When an iteration overflows the buffer, reset grows it to the high water mark so later iterations stay in one block."
+    public:
+        MemoryArena();
+        std::pmr::memory_resource* resource();
+        void reset();
+        size_t capacity();
+
+    private:
+        class CountingResource : public std::pmr::memory_resource
+        {
+            //bytesAllocated "Upstream of the monotonic resource. Counts what did not fit in buffer."
+        public:
+            size_t bytesAllocated = 0;
+        protected:
+            void* do_allocate(size_t bytes, size_t alignment) override;
+            void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+        };
+
+        void newMonotonic();
+
+        std::vector<std::byte> buffer;
+        CountingResource overflow;
+        std::unique_ptr<std::pmr::monotonic_buffer_resource> monotonic;
+    };
+}
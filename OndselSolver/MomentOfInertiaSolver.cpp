@@ -218,6 +218,7 @@ void MbD::MomentOfInertiaSolver::calcAPp()
 	if (lam0 == lam1) {
 		if (lam1 == lam2) {
 			aAPp = FullMatrix<double>::identitysptr(3);
+			return;
 		}
 		else {
 			eigenvector1 = eigenvectorFor(lam1);
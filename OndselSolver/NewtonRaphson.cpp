@@ -6,6 +6,7 @@
  *   See LICENSE file for details about copyright.                         *
  ***************************************************************************/
  
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <cassert>
@@ -30,7 +31,9 @@ void NewtonRaphson::initializeLocally()
 {
 	iterNo = -1;
 	nDivergence = -1;
-	nBackTracking = -1;
+	nBackTracking = 0;
+	nJacobian = 0;
+	iterNoOfJacobian = -1;
 	dxNorms->clear();
 	yNorms->clear();
 	yNormOld = std::numeric_limits<double>::max();
@@ -68,11 +71,16 @@ void NewtonRaphson::iterate()
 	this->fillY();
 	this->calcyNorm();
 	yNorms->push_back(yNorm);
+	yNormOld = yNorm;
 
 	while (true) {
 		this->incrementIterNo();
-		this->fillPyPx();
-		this->solveEquations();
+		if (this->needsNewJacobian() || !this->solveEquationsWithLastJacobian()) {
+			this->fillPyPx();
+			this->solveEquations();
+			nJacobian++;
+			iterNoOfJacobian = iterNo;
+		}
 		this->calcDXNormImproveRootCalcYNorm();
 		if (this->isConverged()) {
 			//std::cout << "iterNo = " << iterNo << std::endl;
@@ -104,6 +112,9 @@ bool NewtonRaphson::isConvergedToNumericalLimit()
 {
 	//"worthIterating is less stringent with IterNo."
 	//"nDivergenceMax is the number of small divergences allowed."
+	//"Only steps with a new Jacobian or a Broyden update are judged. See needsNewJacobian."
+
+	if (iterNo != iterNoOfJacobian && !this->usesBroydenUpdates()) return false;
 
 	auto tooLargeTol = 1.0e-2;
 	constexpr auto smallEnoughTol = std::numeric_limits<double>::epsilon();
@@ -136,15 +147,118 @@ void NewtonRaphson::calcDXNormImproveRootCalcYNorm()
 	dxNorms->push_back(dxNorm);
 	this->updatexold();
 	this->xEqualxoldPlusdx();
+	this->updateSystemCalcYNorm();
+	if (this->usesLineSearch() && iterNo == iterNoOfJacobian) this->backTrack();
+	yNorms->push_back(yNorm);
+	yNormOld = yNorm;
+}
+
+void NewtonRaphson::updateSystemCalcYNorm()
+{
 	this->passRootToSystem();
 	this->askSystemToUpdate();
 	this->fillY();
 	this->calcyNorm();
-	yNorms->push_back(yNorm);
-	yNormOld = yNorm;
+}
+
+bool NewtonRaphson::usesLineSearch()
+{
+	return false;
+}
+
+void NewtonRaphson::backTrack()
+{
+	//"Armijo. The full step is kept when yNorm drops to (1 - twoAlp*lam) of yNormOld."
+	//"Otherwise lam is the minimum of a quadratic in lam through yNormOld, its slope -2*yNormOld and the last trial."
+	//"Each cut is kept within 0.1 to 0.5 of the previous lam."
+	//"dx is a Newton step, so it is a descent direction for yNorm. Reused factors give no such guarantee and are not searched."
+	//"Steps within tooLargeTol are in the quadratic region where yNorm differences are mostly rounding."
+	//"If lam gets below lamMin the search stops, the failure is logged and the full step is taken as before."
+	constexpr auto tooLargeTol = 1.0e-2;
+	constexpr auto lamMin = 0.1;
+	lam = 1.0;
+	if (dxNorm <= tooLargeTol || yNormOld <= yNormTol) return;
+	while (yNorm > ((1.0 - (twoAlp * lam)) * yNormOld)) {
+		auto lamFit = yNormOld * lam * lam / (yNorm - yNormOld + (2.0 * yNormOld * lam));
+		lam = std::clamp(lamFit, 0.1 * lam, 0.5 * lam);
+		if (lam < lamMin) {
+			std::string str = "MbD: Line search failed at iteration " + std::to_string(iterNo) + ". The full Newton step is taken.";
+			system->logString(str);
+			lam = 1.0;
+			this->xEqualxoldPlusdx();
+			this->updateSystemCalcYNorm();
+			return;
+		}
+		nBackTracking++;
+		this->xEqualxoldPluslamdx();
+		this->updateSystemCalcYNorm();
+	}
+}
+
+double NewtonRaphson::linearSolveTolerance()
+{
+	//"Inexact Newton. The linear solve need only reduce the residual as fast as the iteration does."
+	//"Eisenstat-Walker choice 2. yNorm is half the squared residual so its ratio is already squared."
+	constexpr auto gamma = 0.9;
+	constexpr auto forcingTermMax = 0.1;
+	auto nyNorm = yNorms->size();
+	if (iterNo <= 0 || nyNorm < 2 || yNorms->at(nyNorm - 2) == 0.0) {
+		forcingTerm = forcingTermMax;
+		return forcingTerm;
+	}
+	auto eta = gamma * yNorms->at(nyNorm - 1) / yNorms->at(nyNorm - 2);
+	auto safeguard = gamma * forcingTerm * forcingTerm;
+	if (safeguard > 0.1) eta = std::max(eta, safeguard);
+	forcingTerm = std::min(eta, forcingTermMax);
+	return forcingTerm;
 }
 
 void NewtonRaphson::postRun()
 {
 	system->postNewtonRaphson();
 }
+
+bool NewtonRaphson::needsNewJacobian()
+{
+	//"Modified Newton. Keep the last factors while each step is at most jacobianReuseRatio of the one before."
+	//"Until two steps exist there is no ratio and available factors are tried."
+	//"Steps with reused factors converge only linearly. Once one is within dxTol a full Newton step finishes."
+	//"Broyden updated steps converge superlinearly and may finish by themselves."
+	auto ratioMax = this->jacobianReuseRatio();
+	if (ratioMax <= 0.0 || !this->hasReusableJacobian()) return true;
+	auto nStep = dxNorms->size();
+	if (nStep < 2) return false;
+	auto dxNormLast = dxNorms->at(nStep - 1);
+	auto dxNormOld = dxNorms->at(nStep - 2);
+	if (dxNormLast < dxTol && !this->usesBroydenUpdates()) return true;
+	return dxNormOld == 0.0 || dxNormLast > (ratioMax * dxNormOld);
+}
+
+bool NewtonRaphson::hasReusableJacobian()
+{
+	return false;
+}
+
+double NewtonRaphson::jacobianReuseRatio()
+{
+	//"Zero refactors every iteration."
+	return 0.0;
+}
+
+bool NewtonRaphson::solveEquationsWithLastJacobian()
+{
+	//"Answer false when the factors cannot give a step. A new Jacobian is then taken."
+	//"Solvers without factors to reuse always take a new Jacobian."
+	return false;
+}
+
+bool NewtonRaphson::usesBroydenUpdates()
+{
+	return false;
+}
+
+void NewtonRaphson::reportStats()
+{
+	std::string str = "MbD: Newton iterations = " + std::to_string(iterNo + 1) + ", Jacobians = " + std::to_string(nJacobian) + ", backtracks = " + std::to_string(nBackTracking) + ".";
+	system->logString(str);
+}
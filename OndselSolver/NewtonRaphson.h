@@ -22,7 +22,7 @@ namespace MbD {
 
     class NewtonRaphson : public Solver
     {
-        //system xold x dx dxNorm dxNorms dxTol y yNorm yNormOld yNorms yNormTol pypx iterNo iterMax nDivergence nBackTracking twoAlp lam 
+        //system xold x dx dxNorm dxNorms dxTol y yNorm yNormOld yNorms yNormTol pypx iterNo iterMax nDivergence nBackTracking twoAlp lam forcingTerm nJacobian iterNoOfJacobian 
     public:
         void initialize() override;
         void initializeLocally() override;
@@ -37,18 +37,31 @@ namespace MbD {
         virtual void incrementIterNo();
         virtual void updatexold() = 0;
         virtual void xEqualxoldPlusdx() = 0;
+        virtual void xEqualxoldPluslamdx() = 0;
 
         virtual bool isConverged();
         virtual void askSystemToUpdate();
         virtual void passRootToSystem() = 0;
         bool isConvergedToNumericalLimit();
         void calcDXNormImproveRootCalcYNorm();
+        virtual bool usesLineSearch();
+        void backTrack();
+        void updateSystemCalcYNorm();
+        double linearSolveTolerance();
         void postRun() override;
+        virtual bool needsNewJacobian();
+        virtual bool hasReusableJacobian();
+        virtual double jacobianReuseRatio();
+        virtual bool solveEquationsWithLastJacobian();
+        virtual bool usesBroydenUpdates();
+        void reportStats() override;
         
         SystemSolver* system = nullptr; //Use raw pointer when pointing backwards.
         std::shared_ptr<std::vector<double>> dxNorms, yNorms;
-        double dxNorm = 0.0, yNorm = 0.0, yNormOld = 0.0, yNormTol = 0.0, dxTol = 0.0, twoAlp = 0.0, lam = 0.0;
+        double dxNorm = 0.0, yNorm = 0.0, yNormOld = 0.0, yNormTol = 0.0, dxTol = 0.0, twoAlp = 0.0, lam = 0.0, forcingTerm = 0.0;
         int iterNo = -1, iterMax = -1, nDivergence = -1, nBackTracking = -1;
+        int nJacobian = 0;	//Jacobians filled and factored this run. Other iterations reused the last factors.
+        int iterNoOfJacobian = -1;	//Iteration that last filled and factored pypx.
     };
 }
 
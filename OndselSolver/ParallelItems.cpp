@@ -0,0 +1,94 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+
+#include <exception>
+
+#include "ParallelItems.h"
+#include "System.h"
+#include "Part.h"
+#include "Joint.h"
+#include "WorkStealingPool.h"
+#include "SparseMatrixRecorder.h"
+
+using namespace MbD;
+
+void ParallelItems::runsDo(std::shared_ptr<WorkStealingPool> pool, int nItem, const std::function<void(int run, int start, int end)>& f)
+{
+	//"Errors are rethrown after all runs finish, the one of the earliest run first."
+	auto nRun = pool->numberOfWorkers();
+	std::vector<std::exception_ptr> errors(nRun);
+	for (int run = 0; run < nRun; run++)
+	{
+		auto start = (int)((long long)nItem * run / nRun);
+		auto end = (int)((long long)nItem * (run + 1) / nRun);
+		pool->submit(run, [&, run, start, end](int /*worker*/) {
+			try {
+				f(run, start, end);
+			}
+			catch (...) {
+				errors[run] = std::current_exception();
+			}
+			});
+	}
+	pool->wait();
+	for (auto& error : errors) {
+		if (error) std::rethrow_exception(error);
+	}
+}
+
+std::shared_ptr<Item> ParallelItems::itemAt(System* system, int k)
+{
+	auto nPart = (int)system->parts->size();
+	if (k < nPart) return system->parts->at(k);
+	return system->jointsMotions->at(k - nPart);
+}
+
+void ParallelItems::updateDo(std::shared_ptr<WorkStealingPool> pool, System* system, const std::function<void(std::shared_ptr<Item>)>& f)
+{
+	auto& parts = *system->parts;
+	auto& jointsMotions = *system->jointsMotions;
+	this->runsDo(pool, (int)parts.size(), [&](int, int start, int end) {
+		for (int k = start; k < end; k++) f(parts[k]);
+		});
+	this->runsDo(pool, (int)jointsMotions.size(), [&](int, int start, int end) {
+		for (int k = start; k < end; k++) f(jointsMotions[k]);
+		});
+}
+
+void ParallelItems::fillColumnDo(std::shared_ptr<WorkStealingPool> pool, System* system, FColDsptr col, const std::function<void(std::shared_ptr<Item>, FColDsptr)>& f)
+{
+	auto nRun = pool->numberOfWorkers();
+	auto n = (int)col->size();
+	columns.resize(nRun - 1);
+	for (auto& column : columns) {
+		if (column == nullptr || (int)column->size() != n) column = std::make_shared<FullColumn<double>>(n);
+	}
+	auto nItem = (int)(system->parts->size() + system->jointsMotions->size());
+	this->runsDo(pool, nItem, [&](int run, int start, int end) {
+		auto runCol = col;
+		if (run > 0) {
+			runCol = columns[run - 1];
+			runCol->zeroSelf();
+		}
+		for (int k = start; k < end; k++) f(this->itemAt(system, k), runCol);
+		});
+	for (auto& column : columns) col->equalSelfPlusFullColumnAt(column, 0);
+}
+
+void ParallelItems::fillMatrixDo(std::shared_ptr<WorkStealingPool> pool, System* system, SpMatDsptr mat, const std::function<void(std::shared_ptr<Item>, SpMatDsptr)>& f)
+{
+	auto nRun = pool->numberOfWorkers();
+	while ((int)recorders.size() < nRun) recorders.push_back(std::make_shared<SparseMatrixRecorder>());
+	auto nItem = (int)(system->parts->size() + system->jointsMotions->size());
+	this->runsDo(pool, nItem, [&](int run, int start, int end) {
+		auto& recorder = recorders[run];
+		recorder->clear();
+		for (int k = start; k < end; k++) f(this->itemAt(system, k), recorder);
+		});
+	for (int run = 0; run < nRun; run++) recorders[run]->replayInto(mat);
+}
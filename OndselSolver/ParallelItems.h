@@ -0,0 +1,45 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <functional>
+
+#include "FullColumn.h"
+#include "SparseMatrix.h"
+
+namespace MbD {
+	class System;
+	class Item;
+	class WorkStealingPool;
+	class SparseMatrixRecorder;
+
+	class ParallelItems
+	{
+		//columns recorders
+		//"Parts, joints and motions evaluated on the workers of a pool, one run of consecutive items per worker."
+		//"Updates do all parts before any joint or motion because constraints read the end frames of the parts."
+		//"Fills only read the items. Run 0 adds into the column itself, later runs into columns of their own,"
+		//"which are added in run order. Jacobian additions are recorded per run and replayed in item order,"
+		//"so the Jacobian is the serial one exactly and the column is the same from solve to solve."
+	public:
+		void updateDo(std::shared_ptr<WorkStealingPool> pool, System* system, const std::function<void(std::shared_ptr<Item>)>& f);
+		void fillColumnDo(std::shared_ptr<WorkStealingPool> pool, System* system, FColDsptr col, const std::function<void(std::shared_ptr<Item>, FColDsptr)>& f);
+		void fillMatrixDo(std::shared_ptr<WorkStealingPool> pool, System* system, SpMatDsptr mat, const std::function<void(std::shared_ptr<Item>, SpMatDsptr)>& f);
+
+	private:
+		void runsDo(std::shared_ptr<WorkStealingPool> pool, int nItem, const std::function<void(int run, int start, int end)>& f);
+		std::shared_ptr<Item> itemAt(System* system, int k);
+
+		std::vector<FColDsptr> columns;	//Of runs after the first.
+		std::vector<std::shared_ptr<SparseMatrixRecorder>> recorders;
+	};
+}
+
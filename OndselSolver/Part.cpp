@@ -193,6 +193,24 @@ void Part::asFixed()
 	partFrame->asFixed();
 }
 
+std::shared_ptr<Part> Part::newFixedCopy()
+{
+	//"Fixed at the same place with no markers. Copies may be solved concurrently with the original."
+	auto copy = CREATE<Part>::With(name.c_str());
+	copy->m = m;
+	copy->aJ = aJ;
+	auto qE = CREATE<EulerParameters<double>>::With(4);
+	qE->equalArrayAt(partFrame->qE, 0);
+	copy->qX(partFrame->qX->copy());
+	copy->qE(qE);
+	copy->qXdot(partFrame->qXdot->copy());
+	copy->omeOpO(this->omeOpO());
+	copy->qXddot(partFrame->qXddot->copy());
+	copy->partFrame->qEddot = partFrame->qEddot->copy();
+	copy->asFixed();
+	return copy;
+}
+
 void Part::postInput()
 {
 	partFrame->postInput();
@@ -363,6 +381,11 @@ void Part::postPosICIteration()
 	partFrame->postPosICIteration();
 }
 
+bool Part::hasMoved()
+{
+	return partFrame->hasMoved;
+}
+
 void Part::fillPosICError(FColDsptr col)
 {
 	partFrame->fillPosICError(col);
@@ -57,6 +57,7 @@ namespace MbD {
 		
 		void setSystem(System* sys);
 		void asFixed();
+		std::shared_ptr<Part> newFixedCopy();
 		void postInput() override;
 		void calcPostDynCorrectorIteration() override;
 
@@ -81,6 +82,7 @@ namespace MbD {
 		void setqsudot(FColDsptr col) override;
 		void setqsudotlam(FColDsptr col) override;
 		void postPosICIteration() override;
+		bool hasMoved() override;
 		void fillPosICError(FColDsptr col) override;
 		void fillPosICJacob(SpMatDsptr mat) override;
 		void removeRedundantConstraints(std::shared_ptr<std::vector<int>> redundantEqnNos) override;
@@ -200,6 +200,8 @@ void PartFrame::prePosIC()
 	markerFramesDo([](std::shared_ptr<MarkerFrame> markerFrm) { markerFrm->prePosIC(); });
 	aGeu->prePosIC();
 	aGabsDo([](std::shared_ptr<Constraint> aGab) { aGab->prePosIC(); });
+	//"Everything that depends on qX and qE is being calculated from them now."
+	hasMoved = false;
 }
 
 void PartFrame::prePosKine()
@@ -210,6 +212,7 @@ void PartFrame::prePosKine()
 	markerFramesDo([](std::shared_ptr<MarkerFrame> markerFrm) { markerFrm->prePosKine(); });
 	aGeu->prePosKine();
 	aGabsDo([](std::shared_ptr<Constraint> aGab) { aGab->prePosKine(); });
+	hasMoved = false;
 }
 
 FColDsptr PartFrame::rOpO()
@@ -309,8 +312,23 @@ void PartFrame::useEquationNumbers()
 	aGabsDo([](std::shared_ptr<Constraint> con) { con->useEquationNumbers(); });
 }
 
+bool PartFrame::isMovedBy(FColDsptr col)
+{
+	//"The same as a nonzero dx in the slices of qX and qE, but also right after backtracking or a restart."
+	for (int i = 0; i < 3; i++)
+	{
+		if (qX->at(i) != col->at(iqX + i)) return true;
+	}
+	for (int i = 0; i < 4; i++)
+	{
+		if (qE->at(i) != col->at(iqE + i)) return true;
+	}
+	return false;
+}
+
 void PartFrame::setqsu(FColDsptr col)
 {
+	if (!hasMoved) hasMoved = this->isMovedBy(col);
 	qX->equalFullColumnAt(col, iqX);
 	qE->equalFullColumnAt(col, iqE);
 	markerFramesDo([&](std::shared_ptr<MarkerFrame> markerFrame) { markerFrame->setqsu(col); });
@@ -320,6 +338,7 @@ void PartFrame::setqsu(FColDsptr col)
 
 void PartFrame::setqsulam(FColDsptr col)
 {
+	if (!hasMoved) hasMoved = this->isMovedBy(col);
 	qX->equalFullColumnAt(col, iqX);
 	qE->equalFullColumnAt(col, iqE);
 	markerFramesDo([&](std::shared_ptr<MarkerFrame> markerFrame) { markerFrame->setqsulam(col); });
@@ -82,6 +82,7 @@ namespace MbD {
 		void fillqsudot(FColDsptr col) override;
 		void fillqsudotWeights(DiagMatDsptr diagMat) override;
 		void useEquationNumbers() override;
+		bool isMovedBy(FColDsptr col);
 		void setqsu(FColDsptr col) override;
 		void setqsulam(FColDsptr col) override;
 		void setqsudotlam(FColDsptr col) override;
@@ -118,6 +119,7 @@ namespace MbD {
 		std::shared_ptr<Constraint> aGeu;
 		std::shared_ptr<std::vector<std::shared_ptr<Constraint>>> aGabs;
 		std::shared_ptr<std::vector<std::shared_ptr<MarkerFrame>>> markerFrames;
+		bool hasMoved = true;	//qX or qE set to new values since position Newton last updated the system.
 	};
 }
 
@@ -8,15 +8,18 @@
 
 #include <assert.h>
 #include <exception>
+#include <algorithm>
+#include <sstream>
 
 #include "PosICNewtonRaphson.h"
 #include "SingularMatrixError.h"
+#include "MaximumIterationError.h"
 #include "SystemSolver.h"
 #include "Part.h"
 #include "Constraint.h"
 #include "CREATE.h"
 #include "GESpMatParPvPrecise.h"
-#include "GESpMatFullPvPosIC.h"
+#include "GESpMatFullPvPosICFast.h"
 
 using namespace MbD;
 
@@ -28,14 +31,13 @@ void PosICNewtonRaphson::run()
 			preRun();
 			initializeLocally();
 			initializeGlobally();
-			iterate();
+			iterateOrContinue();
+			reportStats();
 			postRun();
 			break;
 		}
 		catch (SingularMatrixError ex) {
-			auto redundantEqnNos = ex.getRedundantEqnNos();
-			system->partsJointsMotionsDo([&](std::shared_ptr<Item> item) { item->removeRedundantConstraints(redundantEqnNos); });
-			system->partsJointsMotionsDo([&](std::shared_ptr<Item> item) { item->constraintsReport(); });
+			this->removeRedundantConstraints(ex.getRedundantEqnNos());
 			system->partsJointsMotionsDo([&](std::shared_ptr<Item> item) { item->setqsu(qsuOld); });
 		}
 	}
@@ -94,11 +96,160 @@ void PosICNewtonRaphson::assignEquationNumbers()
 	pivotRowLimits = std::make_shared<std::vector<int>>(rangelimits);
 }
 
+void PosICNewtonRaphson::fillY()
+{
+	AnyPosICNewtonRaphson::fillY();
+	if (homotopyParameter < 1.0) y->equalSelfPlusFullColumntimes(yStart, homotopyParameter - 1.0);
+}
+
+void PosICNewtonRaphson::incrementIterNo()
+{
+	if (iterNo >= iterMax && stopsQuietly) throw MaximumIterationError("");
+	PosNewtonRaphson::incrementIterNo();
+}
+
+void PosICNewtonRaphson::iterateOrContinue()
+{
+	//"Newton from the input positions first. Continuation only when that does not converge."
+	homotopyParameter = 1.0;
+	stopsQuietly = system->useHomotopyPosIC;
+	if (!stopsQuietly) {
+		this->iterate();
+		return;
+	}
+	auto qsuStart = std::make_shared<FullColumn<double>>(nqsu);
+	for (int i = 0; i < nqsu; i++) qsuStart->at(i) = x->at(i);
+	try {
+		this->iterate();
+		stopsQuietly = false;
+		return;
+	}
+	catch (MaximumIterationError ex) {
+	}
+	this->iterateByHomotopyFrom(qsuStart);
+}
+
+void PosICNewtonRaphson::iterateByHomotopyFrom(FColDsptr qsuStart)
+{
+	//"Constraint errors go from their values at qsuStart to zero as (1 - s)*yStart with s from 0 to 1."
+	//"Each increment starts from the root of the last, which also becomes qsuOld with zero lambdas."
+	//"The weighted distance to qsuOld and hence the lambdas stay small. Far from assembly they would be large,"
+	//"and so would the error of the lambda weighted second derivatives in pypx."
+	//"An increment without convergence in iterMaxHomotopy is halved and retried. A quick one doubles the next."
+	std::string str = "MbD: Assembling by continuation from the input positions.";
+	system->logString(str);
+	constexpr auto dsMin = 1.0e-4;
+	auto iterMaxOld = iterMax;
+	nHomotopyIncrement = 0;
+	nHomotopyRetry = 0;
+	auto s = 0.0;
+	auto ds = system->homotopyFirstIncrementPosIC;
+	auto qsuLast = qsuStart->copy();
+	auto keepsRemovedConstraints = false;
+	while (s < 1.0) {
+		if (ds < dsMin || (nHomotopyIncrement + nHomotopyRetry) >= system->homotopyIncrementMaxPosIC) {
+			iterMax = iterMaxOld;
+			iterNo = nHomotopyIncrement + nHomotopyRetry;
+			stopsQuietly = false;
+			this->stopForNoConvergence();
+		}
+		if (removedConstraints && !keepsRemovedConstraints) this->reinstateRemovedConstraints();
+		keepsRemovedConstraints = false;
+		homotopyParameter = std::min(s + ds, 1.0);
+		this->startHomotopyIncrement(qsuStart, qsuLast);
+		iterMax = iterMaxHomotopy;
+		stopsQuietly = true;
+		auto converged = true;
+		try {
+			this->iterate();
+		}
+		catch (MaximumIterationError ex) {
+			converged = false;
+		}
+		catch (SingularMatrixError ex) {
+			//"Which constraints are redundant depends on the configuration. Those found at the root of the last"
+			//"increment are removed for this increment only. Elsewhere a shorter increment may step past the singularity."
+			auto redundantEqnNos = ex.getRedundantEqnNos();
+			if (iterNo == 0 && redundantEqnNos && !redundantEqnNos->empty()) {
+				this->removeRedundantConstraints(redundantEqnNos);
+				keepsRemovedConstraints = true;
+				nHomotopyRetry++;
+				continue;
+			}
+			converged = false;
+		}
+		if (!converged) {
+			nHomotopyRetry++;
+			ds = 0.5 * ds;
+			continue;
+		}
+		nHomotopyIncrement++;
+		s = homotopyParameter;
+		for (int i = 0; i < nqsu; i++) qsuLast->at(i) = x->at(i);
+		if (iterNo < iterNoQuickHomotopy) ds = 2.0 * ds;
+	}
+	iterMax = iterMaxOld;
+	stopsQuietly = false;
+	std::stringstream ss;
+	ss << "MbD: Continuation increments = " << nHomotopyIncrement << ", retries = " << nHomotopyRetry << ".";
+	str = ss.str();
+	system->logString(str);
+}
+
+void PosICNewtonRaphson::startHomotopyIncrement(FColDsptr qsuStart, FColDsptr qsuLast)
+{
+	//"Equations are renumbered when the set of constraints changes. yStart is refilled for them at qsuStart."
+	system->partsJointsMotionsDo([&](std::shared_ptr<Item> item) { item->setqsu(qsuStart); });
+	PosNewtonRaphson::preRun();
+	this->initializeLocally();
+	this->initializeGlobally();
+	this->askSystemToUpdate();
+	AnyPosICNewtonRaphson::fillY();
+	yStart = y->copy();
+	for (int i = 0; i < nqsu; i++) yStart->at(i) = 0.0;
+	qsuOld = qsuLast->copy();
+	x->zeroSelf();
+	x->atiputFullColumn(0, qsuLast);
+	this->passRootToSystem();
+	this->askSystemToUpdate();
+}
+
+void PosICNewtonRaphson::removeRedundantConstraints(std::shared_ptr<std::vector<int>> redundantEqnNos)
+{
+	system->partsJointsMotionsDo([&](std::shared_ptr<Item> item) { item->removeRedundantConstraints(redundantEqnNos); });
+	system->partsJointsMotionsDo([&](std::shared_ptr<Item> item) { item->constraintsReport(); });
+	removedConstraints = true;
+}
+
+void PosICNewtonRaphson::reinstateRemovedConstraints()
+{
+	//"Constraints found redundant in one configuration need not be redundant in another."
+	system->partsJointsMotionsDo([&](std::shared_ptr<Item> item) { item->reactivateRedundantConstraints(); });
+	removedConstraints = false;
+}
+
 bool PosICNewtonRaphson::isConverged()
 {
+	if (stopsQuietly && this->isDiverging()) throw MaximumIterationError("");
 	return this->isConvergedToNumericalLimit();
 }
 
+bool PosICNewtonRaphson::isDiverging()
+{
+	//"Far too large steps that have grown nGrowthMax times in a row will not converge from here."
+	//"isConvergedToNumericalLimit keeps iterating on far too large steps, so without continuation they run to iterMax."
+	constexpr auto tooLargeTol = 1.0e-2;
+	constexpr int nGrowthMax = 3;
+	auto nStep = (int)dxNorms->size();
+	if (nStep <= nGrowthMax) return false;
+	for (int k = nStep - nGrowthMax; k < nStep; k++)
+	{
+		auto dxNormk = dxNorms->at(k);
+		if (dxNormk <= tooLargeTol || dxNormk <= dxNorms->at(k - 1)) return false;
+	}
+	return true;
+}
+
 void PosICNewtonRaphson::handleSingularMatrix()
 {
 	nSingularMatrixError++;
@@ -107,29 +258,38 @@ void PosICNewtonRaphson::handleSingularMatrix()
 		matrixSolver = this->matrixSolverClassNew();
 	}
 	else {
-        auto& r = *matrixSolver;
-		std::string str = typeid(r).name();
-		if (str.find("GESpMatParPvMarkoFast") != std::string::npos) {
-		matrixSolver = CREATE<GESpMatParPvPrecise>::With();
-		this->solveEquations();
+		if (!matrixSolver->isPrecise()) {
+			matrixSolver = CREATE<GESpMatParPvPrecise>::With();
+			this->solveEquations();
 		}
 		else {
-			str = typeid(*matrixSolver).name();
-			if (str.find("GESpMatParPvPrecise") != std::string::npos) {
-				this->lookForRedundantConstraints();
-				matrixSolver = this->matrixSolverClassNew();
-			} else {
-				assert(false);
-			}
+			this->lookForRedundantConstraints();
+			matrixSolver = this->matrixSolverClassNew();
 		}
 	}
 }
 
+void PosICNewtonRaphson::basicSolveEquations()
+{
+	//"Redundant constraints make pypx singular, which only elimination detects."
+	//"With the Krylov solver the first iteration is therefore solved by elimination."
+	if (iterNo == 0 && this->usesKrylovSolver()) {
+		auto krylovSolver = matrixSolver;
+		matrixSolver = this->eliminationSolverNew();
+		SystemNewtonRaphson::basicSolveEquations();
+		matrixSolver = krylovSolver;
+		return;
+	}
+	SystemNewtonRaphson::basicSolveEquations();
+}
+
 void PosICNewtonRaphson::lookForRedundantConstraints()
 {
 	std::string str("MbD: Checking for redundant constraints.");
 	system->logString(str);
-	auto posICsolver = CREATE<GESpMatFullPvPosIC>::With();
+	auto posICsolver = CREATE<GESpMatFullPvPosICFast>::With();
 	posICsolver->system = this;
-	dx = posICsolver->solvewithsaveOriginal(pypx, y->negated(), false);
+	posICsolver->scratchResource = iterationArena.resource();
+	y->negatedInto(minusY);
+	dx = posICsolver->solvewithsaveOriginal(pypx, minusY, false);
 }
@@ -15,18 +15,33 @@ namespace MbD {
     {
       //IC with over, fully or under constrained system
       //Perform redundant constraint removal for over constrained system
-      //pivotRowLimits
+      //pivotRowLimits homotopyParameter yStart stopsQuietly iterMaxHomotopy iterNoQuickHomotopy nHomotopyIncrement nHomotopyRetry removedConstraints
     public:
         PosICNewtonRaphson(){}
 
         void run() override;
         void preRun() override;
         void assignEquationNumbers() override;
+        void fillY() override;
+        void incrementIterNo() override;
+        void iterateOrContinue();
+        void iterateByHomotopyFrom(FColDsptr qsuStart);
+        void startHomotopyIncrement(FColDsptr qsuStart, FColDsptr qsuLast);
+        void removeRedundantConstraints(std::shared_ptr<std::vector<int>> redundantEqnNos);
+        void reinstateRemovedConstraints();
         bool isConverged() override;
+        bool isDiverging();
+        void basicSolveEquations() override;
         void handleSingularMatrix() override;
         void lookForRedundantConstraints();
 
         std::shared_ptr<std::vector<int>> pivotRowLimits;
+        double homotopyParameter = 1.0;	//Fraction of the way from the errors at the input positions to zero errors.
+        FColDsptr yStart;	//Constraint errors at the start of continuation. Zero in the qsu rows.
+        int iterMaxHomotopy = 10, iterNoQuickHomotopy = 6;	//Iterations allowed per increment, and few enough to double the next.
+        bool stopsQuietly = false;	//iterMax or divergence throws MaximumIterationError so that continuation can take over.
+        int nHomotopyIncrement = 0, nHomotopyRetry = 0;
+        bool removedConstraints = false;
     };
 }
 
@@ -11,6 +11,7 @@
 #include "Part.h"
 #include "NotKinematicError.h"
 #include "Constraint.h"
+#include "MatrixSolver.h"
 #include <iostream>
 
 using namespace MbD;
@@ -21,13 +22,19 @@ void PosKineNewtonRaphson::initializeGlobally()
 	system->partsJointsMotionsDo([&](std::shared_ptr<Item> item) { item->fillqsu(x); });
 	iterMax = system->iterMaxPosKine;
 	dxTol = system->errorTolPosKine;
+	//"Successive kinematic steps have nearly the same Jacobian. Start from the factors of the previous step."
+	auto factorization = system->kineFactorization;
+	system->kineFactorization = nullptr;
+	if (this->jacobianReuseRatio() <= 0.0 || factorization == nullptr || this->usesKrylovSolver()) return;
+	if (!factorization->hasReusableFactorsOfOrder(n)) return;
+	matrixSolver = factorization;
 }
 
 void PosKineNewtonRaphson::fillPyPx()
 {
 	pypx->zeroSelf();
-	system->partsJointsMotionsDo([&](std::shared_ptr<Item> item) {
-		item->fillPosKineJacob(pypx);
+	system->partsJointsMotionsFillMatrix(pypx, [&](std::shared_ptr<Item> item, SpMatDsptr mat) {
+		item->fillPosKineJacob(mat);
 		});
 }
 
@@ -81,10 +88,43 @@ void PosKineNewtonRaphson::preRun()
 void PosKineNewtonRaphson::fillY()
 {
 	y->zeroSelf();
-	system->partsJointsMotionsDo([&](std::shared_ptr<Item> item) {
-		item->fillPosKineError(y);
+	system->partsJointsMotionsFillColumn(y, [&](std::shared_ptr<Item> item, FColDsptr col) {
+		item->fillPosKineError(col);
 		//std::cout << item->name << *y << std::endl;
 		//noop();
 		});
 	//std::cout << "Final" << *y << std::endl;
 }
+
+bool PosKineNewtonRaphson::usesKrylovSolver()
+{
+	return system->useKrylovSolverPosKine;
+}
+
+bool PosKineNewtonRaphson::usesBlockTriangularForm()
+{
+	return system->useBlockTriangularFormPosKine;
+}
+
+double PosKineNewtonRaphson::jacobianReuseRatio()
+{
+	return system->jacobianReuseRatioPosKine;
+}
+
+bool PosKineNewtonRaphson::usesLineSearch()
+{
+	return system->useLineSearchPosKine;
+}
+
+bool PosKineNewtonRaphson::updatesMovedOnly()
+{
+	return system->useMovedPartsOnlyPosKine;
+}
+
+void PosKineNewtonRaphson::postRun()
+{
+	//"Velocity has the same Jacobian. Hand over its last factors."
+	PosNewtonRaphson::postRun();
+	if (!system->reuseKineFactorization) return;
+	if (matrixSolver->hasReusableFactors()) system->kineFactorization = matrixSolver;
+}
@@ -21,6 +21,12 @@ namespace MbD {
         void assignEquationNumbers() override;
         void preRun() override;
         void fillY() override;
+        bool usesKrylovSolver() override;
+        bool usesBlockTriangularForm() override;
+        double jacobianReuseRatio() override;
+        bool usesLineSearch() override;
+        bool updatesMovedOnly() override;
+        void postRun() override;
 
     };
 }
@@ -12,6 +12,8 @@
 #include "PosNewtonRaphson.h"
 #include "SystemSolver.h"
 #include "SimulationStoppingError.h"
+#include "Part.h"
+#include "PartFrame.h"
 
 using namespace MbD;
 
@@ -22,30 +24,53 @@ void PosNewtonRaphson::preRun()
 
 void PosNewtonRaphson::incrementIterNo()
 {
-	if (iterNo >= iterMax)
-	{
-		std::stringstream ss;
-		ss << "MbD: No convergence after " << iterNo << " iterations.";
-		auto str = ss.str();
-		system->logString(str);
-		ss.str("");
-		ss << "MbD: A geometrically incompatible system has been specified.";
-		str = ss.str();
-		system->logString(str);
-		ss.str("");
-		ss << "MbD: Or the system parts are distributed too far apart from the assembled positions.";
-		str = ss.str();
-		system->logString(str);
-
-		throw SimulationStoppingError("");
-	}
-	
+	if (iterNo >= iterMax) this->stopForNoConvergence();
 	iterNo++;
 }
 
+void PosNewtonRaphson::stopForNoConvergence()
+{
+	std::stringstream ss;
+	ss << "MbD: No convergence after " << iterNo << " iterations.";
+	auto str = ss.str();
+	system->logString(str);
+	ss.str("");
+	ss << "MbD: A geometrically incompatible system has been specified.";
+	str = ss.str();
+	system->logString(str);
+	ss.str("");
+	ss << "MbD: Or the system parts are distributed too far apart from the assembled positions.";
+	str = ss.str();
+	system->logString(str);
+
+	throw SimulationStoppingError("");
+}
+
 void PosNewtonRaphson::askSystemToUpdate()
 {
-	system->partsJointsMotionsDo([&](std::shared_ptr<Item> item) { item->postPosICIteration(); });
+	//"Parts that did not move keep their markers and end frames. Joints and motions between such parts keep their constraints,"
+	//"unless position IC has set a new lam on one of them. See Joint::hasMoved."
+	//"Motions depend on time too, but time is fixed during a solve."
+	//"Constraints that depend on more than their own end frames, as in gear and rack pinion joints,"
+	//"or whose aConstant was set since the last solve, are not tracked. Hence it is off by default."
+	if (!this->updatesMovedOnly()) {
+		system->partsJointsMotionsConcurrentlyDo([&](std::shared_ptr<Item> item) { item->postPosICIteration(); });
+		return;
+	}
+	system->partsJointsMotionsConcurrentlyDo([&](std::shared_ptr<Item> item) {
+		if (item->hasMoved()) item->postPosICIteration();
+		});
+	for (auto& part : *system->parts()) part->partFrame->hasMoved = false;
+}
+
+bool PosNewtonRaphson::updatesMovedOnly()
+{
+	return system->useMovedPartsOnlyPosIC;
+}
+
+bool PosNewtonRaphson::usesLineSearch()
+{
+	return system->useLineSearchPosIC;
 }
 
 void PosNewtonRaphson::postRun()
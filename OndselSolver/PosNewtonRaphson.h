@@ -17,7 +17,10 @@ namespace MbD {
     public:
         void preRun() override;
         void incrementIterNo() override;
+        void stopForNoConvergence();
         void askSystemToUpdate() override;
+        virtual bool updatesMovedOnly();
+        bool usesLineSearch() override;
         void postRun() override;
     };
 }
@@ -0,0 +1,199 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+
+#include <map>
+#include <algorithm>
+
+#include "RigidCluster.h"
+#include "Part.h"
+#include "PartFrame.h"
+#include "MarkerFrame.h"
+#include "Joint.h"
+#include "EndFramec.h"
+#include "EulerParameters.h"
+#include "DiagonalMatrix.h"
+#include "MomentOfInertiaSolver.h"
+#include "CREATE.h"
+
+using namespace MbD;
+
+bool RigidCluster::isFixed(std::shared_ptr<Part> part)
+{
+	return !part->partFrame->aGabs->empty();
+}
+
+Mat3 RigidCluster::aAOpOf(std::shared_ptr<Part> part)
+{
+	//"From normalized input Euler parameters. qE of the part is left as it is."
+	auto qE = CREATE<EulerParameters<double>>::With(4);
+	qE->equalArrayAt(part->partFrame->qE, 0);
+	qE->conditionSelf();
+	qE->calc();
+	return Mat3::fromFullMatrix(qE->aA);
+}
+
+void RigidCluster::calcBody()
+{
+	//"Place the parts relative to the first fixed part, or else the first part, through a spanning tree of fixedJoints."
+	//"The marker axes of a fixed joint coincide up to a half turn about one of them. The input positions decide which."
+	//"The body frame is at the combined mass center along its principal axes, or at the fixed part."
+	auto nPart = (int)parts.size();
+	auto it = std::find_if(parts.begin(), parts.end(), [](auto& part) { return isFixed(part); });
+	auto reference = (it == parts.end()) ? 0 : (int)(it - parts.begin());
+	std::map<Part*, int> partNos;
+	for (int i = 0; i < nPart; i++) partNos[parts[i].get()] = i;
+	auto partNoOf = [&](EndFrmsptr& frm) { return partNos[frm->getMarkerFrame()->getPartFrame()->getPart()]; };
+	std::vector<Vec3> rPpPs(nPart);
+	std::vector<Mat3> aAPps(nPart);
+	std::vector<bool> isPlaced(nPart, false);
+	aAPps[reference] = Mat3::identity();
+	isPlaced[reference] = true;
+	auto placesMore = true;
+	while (placesMore) {
+		placesMore = false;
+		for (auto& joint : fixedJoints) {
+			auto i = partNoOf(joint->frmI);
+			auto j = partNoOf(joint->frmJ);
+			if (isPlaced[i] == isPlaced[j]) continue;
+			auto k = isPlaced[i] ? i : j;
+			auto u = isPlaced[i] ? j : i;
+			auto markerk = (k == i ? joint->frmI : joint->frmJ)->getMarkerFrame();
+			auto markeru = (k == i ? joint->frmJ : joint->frmI)->getMarkerFrame();
+			auto aApmk = Mat3::fromFullMatrix(markerk->aApm);
+			auto aApmu = Mat3::fromFullMatrix(markeru->aApm);
+			auto aAmkmuInput = aAOpOf(parts[k]).timesFixedMatrix(aApmk).transposeTimesFixedMatrix(aAOpOf(parts[u]).timesFixedMatrix(aApmu));
+			auto aAmkmu = Mat3();
+			aAmkmu.at(0, 0) = (aAmkmuInput.at(0, 0) < 0.0) ? -1.0 : 1.0;
+			aAmkmu.at(1, 1) = (aAmkmuInput.at(1, 1) < 0.0) ? -1.0 : 1.0;
+			aAmkmu.at(2, 2) = aAmkmu.at(0, 0) * aAmkmu.at(1, 1);
+			auto rPmkP = rPpPs[k].plusFixedColumn(aAPps[k].timesFixedColumn(Vec3::fromFullColumn(markerk->rpmp)));
+			aAPps[u] = aAPps[k].timesFixedMatrix(aApmk).timesFixedMatrix(aAmkmu).timesTransposeFixedMatrix(aApmu);
+			rPpPs[u] = rPmkP.minusFixedColumn(aAPps[u].timesFixedColumn(Vec3::fromFullColumn(markeru->rpmp)));
+			isPlaced[u] = true;
+			placesMore = true;
+		}
+	}
+	//"aJPP = sum of aAPp*aJ*aAPpT - m*(rPpPTilde*rPpPTilde) about the reference origin."
+	auto mass = 0.0;
+	Vec3 mrPcmP;
+	Mat3 aJPP;
+	for (int i = 0; i < nPart; i++)
+	{
+		auto& part = parts[i];
+		auto& rPpP = rPpPs[i];
+		auto& aAPp = aAPps[i];
+		Mat3 aJ;
+		for (int ii = 0; ii < 3; ii++) aJ.at(ii, ii) = part->aJ->at(ii);
+		auto aJPPi = aAPp.timesFixedMatrix(aJ).timesTransposeFixedMatrix(aAPp);
+		auto rPpPSq = rPpP.dot(rPpP);
+		for (int ii = 0; ii < 3; ii++) {
+			for (int jj = 0; jj < 3; jj++) {
+				auto rrT = rPpP.at(ii) * rPpP.at(jj);
+				aJPP.at(ii, jj) += aJPPi.at(ii, jj) + part->m * ((ii == jj ? rPpPSq : 0.0) - rrT);
+			}
+		}
+		mass += part->m;
+		mrPcmP = mrPcmP.plusFixedColumn(rPpP.times(part->m));
+	}
+	Vec3 rPcP;
+	auto aAPc = Mat3::identity();
+	auto aJ = std::make_shared<DiagonalMatrix<double>>(3, 0.0);
+	if (mass > 0.0) {
+		auto rPcmP = mrPcmP.times(1.0 / mass);
+		auto solver = std::make_shared<MomentOfInertiaSolver>();
+		solver->setm(mass);
+		solver->setJPP(aJPP.toFullMatrix());
+		solver->setrPoP(rPcmP.toFullColumn());
+		solver->setAPo(FullMatrix<double>::identitysptr(3));
+		solver->setrPcmP(rPcmP.toFullColumn());
+		solver->calc();
+		aJ = solver->aJpp;
+		if (!isFixed(parts[reference])) {
+			rPcP = rPcmP;
+			aAPc = Mat3::fromFullMatrix(solver->aAPp);
+		}
+	}
+	rcpcs.resize(nPart);
+	aAcps.resize(nPart);
+	for (int i = 0; i < nPart; i++)
+	{
+		rcpcs[i] = aAPc.transposeTimesFixedColumn(rPpPs[i].minusFixedColumn(rPcP));
+		aAcps[i] = aAPc.transposeTimesFixedMatrix(aAPps[i]);
+	}
+	auto& referencePart = parts[reference];
+	body = CREATE<Part>::With(referencePart->name.c_str());
+	body->m = mass;
+	body->aJ = aJ;
+	if (isFixed(referencePart)) {
+		auto qE = CREATE<EulerParameters<double>>::With(4);
+		qE->equalArrayAt(referencePart->partFrame->qE, 0);
+		body->qX(referencePart->partFrame->qX->copy());
+		body->qE(qE);
+		body->asFixed();
+	}
+	else {
+		auto aAOP = aAOpOf(referencePart);
+		auto rOPO = Vec3::fromFullColumn(referencePart->partFrame->qX);
+		body->qX(rOPO.plusFixedColumn(aAOP.timesFixedColumn(rPcP)).toFullColumn());
+		body->setaAap(aAOP.timesFixedMatrix(aAPc).toFullMatrix());
+	}
+	body->omeOpO(std::make_shared<FullColumn<double>>(3, 0.0));
+	body->initializeLocally();
+	body->initializeGlobally();
+}
+
+void RigidCluster::moveMarkersToBody()
+{
+	for (int i = 0; i < (int)parts.size(); i++)
+	{
+		auto& partFrame = parts[i]->partFrame;
+		for (auto& markerFrame : *partFrame->markerFrames) {
+			markerFrames.push_back(markerFrame);
+			partFrames.push_back(partFrame.get());
+			rpmps.push_back(markerFrame->rpmp);
+			aApms.push_back(markerFrame->aApm);
+			auto rpmp = Vec3::fromFullColumn(markerFrame->rpmp);
+			auto aApm = Mat3::fromFullMatrix(markerFrame->aApm);
+			auto rcmc = rcpcs[i].plusFixedColumn(aAcps[i].timesFixedColumn(rpmp));
+			auto aAcm = aAcps[i].timesFixedMatrix(aApm);
+			markerFrame->setPartFramerpmpaApm(body->partFrame.get(), rcmc.toFullColumn(), aAcm.toFullMatrix());
+			body->partFrame->markerFrames->push_back(markerFrame);
+		}
+	}
+}
+
+void RigidCluster::restoreMarkers()
+{
+	for (int k = 0; k < (int)markerFrames.size(); k++)
+	{
+		markerFrames[k]->setPartFramerpmpaApm(partFrames[k], rpmps[k], aApms[k]);
+	}
+	markerFrames.clear();
+	partFrames.clear();
+	rpmps.clear();
+	aApms.clear();
+	body->partFrame->markerFrames->clear();
+}
+
+void RigidCluster::setPartsFromBody()
+{
+	//"Fixed parts stay where they are. Euler parameters keep the sign of the input."
+	auto rOcO = Vec3::fromFullColumn(body->partFrame->qX);
+	auto aAOc = aAOpOf(body);
+	for (int i = 0; i < (int)parts.size(); i++)
+	{
+		auto& part = parts[i];
+		if (isFixed(part)) continue;
+		auto& partFrame = part->partFrame;
+		auto qE = aAOc.timesFixedMatrix(aAcps[i]).toFullMatrix()->asEulerParameters();
+		if (qE->dot(partFrame->qE) < 0.0) qE->negateSelf();
+		rOcO.plusFixedColumn(aAOc.timesFixedColumn(rcpcs[i])).copyInto(partFrame->qX);
+		partFrame->qE->equalArrayAt(qE, 0);
+		partFrame->qE->calc();
+	}
+}
@@ -0,0 +1,44 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "FixedMatrix.h"
+
+namespace MbD {
+	class Part;
+	class PartFrame;
+	class MarkerFrame;
+	class Joint;
+
+	class RigidCluster
+	{
+		//parts fixedJoints body rcpcs aAcps markerFrames partFrames rpmps aApms
+		//"Parts held together by fixed joints. Position IC solves for them as one body."
+	public:
+		static bool isFixed(std::shared_ptr<Part> part);
+		static Mat3 aAOpOf(std::shared_ptr<Part> part);
+		void calcBody();
+		void moveMarkersToBody();
+		void restoreMarkers();
+		void setPartsFromBody();
+
+		std::vector<std::shared_ptr<Part>> parts;
+		std::vector<std::shared_ptr<Joint>> fixedJoints;
+		std::shared_ptr<Part> body;
+		std::vector<Vec3> rcpcs;	//Part frame origins in the body frame.
+		std::vector<Mat3> aAcps;	//Part frame axes in the body frame.
+		std::vector<std::shared_ptr<MarkerFrame>> markerFrames;	//Markers of the parts while they are on the body.
+		std::vector<PartFrame*> partFrames;	//Use raw pointer when pointing backwards.
+		std::vector<FColDsptr> rpmps;
+		std::vector<FMatDsptr> aApms;
+	};
+}
@@ -41,3 +41,8 @@ void ScalarNewtonRaphson::xEqualxoldPlusdx()
 {
 	x = xold + dx;
 }
+
+void ScalarNewtonRaphson::xEqualxoldPluslamdx()
+{
+	x = xold + (lam * dx);
+}
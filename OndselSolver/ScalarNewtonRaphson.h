@@ -21,6 +21,7 @@ namespace MbD {
         void updatexold() override;
         void calcdxNorm() override;
         void xEqualxoldPlusdx() override;
+        void xEqualxoldPluslamdx() override;
 
 
         double xold, x, dx, y;
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <sstream> 
+#include <functional>
 
 #include "RowTypeMatrix.h"
 #include "SparseRow.h"
@@ -43,27 +44,31 @@ namespace MbD {
 				this->push_back(row);
 			}
 		}
-		void atiput(int i, SpRowsptr<T> spRow);
-		void atijplusDiagonalMatrix(int i, int j, DiagMatDsptr diagMat);
-		void atijminusDiagonalMatrix(int i, int j, DiagMatDsptr diagMat);
+		virtual ~SparseMatrix() {}
+		virtual void atiput(int i, SpRowsptr<T> spRow);
+		virtual void atijplusDiagonalMatrix(int i, int j, DiagMatDsptr diagMat);
+		virtual void atijminusDiagonalMatrix(int i, int j, DiagMatDsptr diagMat);
 		double sumOfSquares() override;
 		void zeroSelf() override;
-		void atijplusFullRow(int i, int j, FRowsptr<T> fullRow);
-		void atijplusFullColumn(int i, int j, FColsptr<T> fullCol);
-		void atijplusFullMatrix(int i, int j, FMatDsptr fullMat);
-		void atijminusFullMatrix(int i, int j, FMatDsptr fullMat);
-		void atijplusTransposeFullMatrix(int i, int j, FMatDsptr fullMat);
-		void atijplusFullMatrixtimes(int i, int j, FMatDsptr fullMat, T factor);
-		void atijminusFullColumn(int i, int j, FColDsptr fullCol);
-		void atijminusTransposeFullMatrix(int i, int j, FMatDsptr fullMat);
-		void atijplusNumber(int i, int j, double value);
-		void atijminusNumber(int i, int j, double value);
-		void atijput(int i, int j, T value);
+		virtual void atijplusFullRow(int i, int j, FRowsptr<T> fullRow);
+		virtual void atijplusFullColumn(int i, int j, FColsptr<T> fullCol);
+		virtual void atijplusFullMatrix(int i, int j, FMatDsptr fullMat);
+		virtual void atijminusFullMatrix(int i, int j, FMatDsptr fullMat);
+		virtual void atijplusTransposeFullMatrix(int i, int j, FMatDsptr fullMat);
+		virtual void atijplusFullMatrixtimes(int i, int j, FMatDsptr fullMat, T factor);
+		virtual void atijminusFullColumn(int i, int j, FColDsptr fullCol);
+		virtual void atijminusTransposeFullMatrix(int i, int j, FMatDsptr fullMat);
+		virtual void atijplusNumber(int i, int j, double value);
+		virtual void atijminusNumber(int i, int j, double value);
+		virtual void atijput(int i, int j, T value);
+		virtual void atijplusArray(int i, int j, int nrow, int ncol, const T* values);
 		double maxMagnitude() override;
-		FColsptr<T> timesFullColumn(FColsptr<T> fullCol);
-		SpMatsptr<T> plusSparseMatrix(SpMatsptr<T> spMat);
-		std::shared_ptr<SparseMatrix<T>> clonesptr();
-		void magnifySelf(T factor);
+		virtual double maxMagnitudeOfRow(int i);
+		virtual void rowDo(int i, const std::function<void(int, T)>& f);
+		virtual FColsptr<T> timesFullColumn(FColsptr<T> fullCol);
+		virtual SpMatsptr<T> plusSparseMatrix(SpMatsptr<T> spMat);
+		virtual std::shared_ptr<SparseMatrix<T>> clonesptr();
+		virtual void magnifySelf(T factor);
 
 		std::ostream& printOn(std::ostream& s) const override;
 
@@ -188,6 +193,18 @@ namespace MbD {
 		this->at(i)->atiput(j, value);
 	}
 	template<typename T>
+	inline void SparseMatrix<T>::atijplusArray(int i, int j, int nrow, int ncol, const T* values)
+	{
+		//"values holds nrow rows of ncol one after another."
+		for (int ii = 0; ii < nrow; ii++)
+		{
+			for (int jj = 0; jj < ncol; jj++)
+			{
+				this->atijplusNumber(i + ii, j + jj, values[ii * ncol + jj]);
+			}
+		}
+	}
+	template<typename T>
 	inline double SparseMatrix<T>::maxMagnitude()
 	{
 		double max = 0.0;
@@ -199,6 +216,19 @@ namespace MbD {
 		return max;
 	}
 	template<typename T>
+	inline double SparseMatrix<T>::maxMagnitudeOfRow(int i)
+	{
+		return this->at(i)->maxMagnitude();
+	}
+	template<typename T>
+	inline void SparseMatrix<T>::rowDo(int i, const std::function<void(int, T)>& f)
+	{
+		for (auto const& keyValue : *(this->at(i)))
+		{
+			f(keyValue.first, keyValue.second);
+		}
+	}
+	template<typename T>
 	inline std::ostream& SparseMatrix<T>::printOn(std::ostream& s) const
 	{
 		s << "SpMat[" << std::endl;
@@ -228,10 +258,14 @@ namespace MbD {
 		//"Assume all checking of validity of this operation has been done."
 		//"Just evaluate quickly."
 
+		//"spMat is read with rowDo so that it may be a BlockSparseMatrix."
+
 		auto answer = clonesptr();
 		for (int i = 0; i < answer->size(); i++)
 		{
-			answer->atiput(i, answer->at(i)->plusSparseRow(spMat->at(i)));
+			auto row = answer->at(i)->clonesptr();
+			spMat->rowDo(i, [&](int j, T value) { (*row)[j] += value; });
+			answer->atiput(i, row);
 		}
 		return answer;
 	}
@@ -0,0 +1,156 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+
+#include "SparseMatrixRecorder.h"
+
+using namespace MbD;
+
+SparseMatrixRecorder::SparseMatrixRecorder() : SparseMatrix<double>(0)
+{
+}
+
+void SparseMatrixRecorder::clear()
+{
+	//"Capacity is kept for the next fill."
+	windows.clear();
+	values.clear();
+}
+
+void SparseMatrixRecorder::replayInto(SpMatDsptr spMat)
+{
+	for (auto& window : windows)
+	{
+		if (window.isPut) {
+			spMat->atijput(window.i, window.j, values[window.offset]);
+		}
+		else {
+			spMat->atijplusArray(window.i, window.j, window.nrow, window.ncol, values.data() + window.offset);
+		}
+	}
+}
+
+double* SparseMatrixRecorder::addWindow(int i, int j, int nrow, int ncol, bool isPut)
+{
+	auto offset = (int)values.size();
+	windows.push_back({ i, j, nrow, ncol, offset, isPut });
+	values.resize(offset + nrow * ncol);
+	return values.data() + offset;
+}
+
+void SparseMatrixRecorder::atijplusDiagonalMatrix(int i, int j, DiagMatDsptr diagMat)
+{
+	for (int ii = 0; ii < diagMat->nrow(); ii++)
+	{
+		*this->addWindow(i + ii, j + ii, 1, 1) = diagMat->at(ii);
+	}
+}
+
+void SparseMatrixRecorder::atijminusDiagonalMatrix(int i, int j, DiagMatDsptr diagMat)
+{
+	for (int ii = 0; ii < diagMat->nrow(); ii++)
+	{
+		*this->addWindow(i + ii, j + ii, 1, 1) = -diagMat->at(ii);
+	}
+}
+
+void SparseMatrixRecorder::atijplusFullRow(int i, int j, FRowDsptr fullRow)
+{
+	auto n = (int)fullRow->size();
+	auto window = this->addWindow(i, j, 1, n);
+	for (int jj = 0; jj < n; jj++) window[jj] = fullRow->at(jj);
+}
+
+void SparseMatrixRecorder::atijplusFullColumn(int i, int j, FColDsptr fullCol)
+{
+	auto n = (int)fullCol->size();
+	auto window = this->addWindow(i, j, n, 1);
+	for (int ii = 0; ii < n; ii++) window[ii] = fullCol->at(ii);
+}
+
+void SparseMatrixRecorder::atijplusFullMatrix(int i, int j, FMatDsptr fullMat)
+{
+	auto m = fullMat->nrow();
+	auto n = fullMat->ncol();
+	auto window = this->addWindow(i, j, m, n);
+	for (int ii = 0; ii < m; ii++)
+	{
+		for (int jj = 0; jj < n; jj++) window[ii * n + jj] = fullMat->at(ii)->at(jj);
+	}
+}
+
+void SparseMatrixRecorder::atijminusFullMatrix(int i, int j, FMatDsptr fullMat)
+{
+	auto m = fullMat->nrow();
+	auto n = fullMat->ncol();
+	auto window = this->addWindow(i, j, m, n);
+	for (int ii = 0; ii < m; ii++)
+	{
+		for (int jj = 0; jj < n; jj++) window[ii * n + jj] = -fullMat->at(ii)->at(jj);
+	}
+}
+
+void SparseMatrixRecorder::atijplusTransposeFullMatrix(int i, int j, FMatDsptr fullMat)
+{
+	auto m = fullMat->nrow();
+	auto n = fullMat->ncol();
+	auto window = this->addWindow(i, j, n, m);
+	for (int ii = 0; ii < n; ii++)
+	{
+		for (int jj = 0; jj < m; jj++) window[ii * m + jj] = fullMat->at(jj)->at(ii);
+	}
+}
+
+void SparseMatrixRecorder::atijplusFullMatrixtimes(int i, int j, FMatDsptr fullMat, double factor)
+{
+	auto m = fullMat->nrow();
+	auto n = fullMat->ncol();
+	auto window = this->addWindow(i, j, m, n);
+	for (int ii = 0; ii < m; ii++)
+	{
+		for (int jj = 0; jj < n; jj++) window[ii * n + jj] = fullMat->at(ii)->at(jj) * factor;
+	}
+}
+
+void SparseMatrixRecorder::atijminusFullColumn(int i, int j, FColDsptr fullCol)
+{
+	auto n = (int)fullCol->size();
+	auto window = this->addWindow(i, j, n, 1);
+	for (int ii = 0; ii < n; ii++) window[ii] = -fullCol->at(ii);
+}
+
+void SparseMatrixRecorder::atijminusTransposeFullMatrix(int i, int j, FMatDsptr fullMat)
+{
+	auto m = fullMat->nrow();
+	auto n = fullMat->ncol();
+	auto window = this->addWindow(i, j, n, m);
+	for (int ii = 0; ii < n; ii++)
+	{
+		for (int jj = 0; jj < m; jj++) window[ii * m + jj] = -fullMat->at(jj)->at(ii);
+	}
+}
+
+void SparseMatrixRecorder::atijplusNumber(int i, int j, double value)
+{
+	*this->addWindow(i, j, 1, 1) = value;
+}
+
+void SparseMatrixRecorder::atijminusNumber(int i, int j, double value)
+{
+	*this->addWindow(i, j, 1, 1) = -value;
+}
+
+void SparseMatrixRecorder::atijput(int i, int j, double value)
+{
+	*this->addWindow(i, j, 1, 1, true) = value;
+}
+
+void SparseMatrixRecorder::atijplusArray(int i, int j, int nrow, int ncol, const double* array)
+{
+	auto window = this->addWindow(i, j, nrow, ncol);
+	for (int k = 0; k < nrow * ncol; k++) window[k] = array[k];
+}
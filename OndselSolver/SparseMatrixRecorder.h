@@ -0,0 +1,53 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "SparseMatrix.h"
+
+namespace MbD {
+	class SparseMatrixRecorder : public SparseMatrix<double>
+	{
+		//windows values
+		//"Stands in for a Jacobian while items fill it. Keeps every addition, in order, as a window of values."
+		//"Subtractions are kept negated. replayInto adds the windows to the Jacobian in the same order and shapes,"
+		//"so its entries and its scatter map come out exactly as if the items had filled it directly."
+	public:
+		struct Window {
+			int i, j, nrow, ncol, offset;
+			bool isPut;
+		};
+
+		SparseMatrixRecorder();
+		void clear();
+		void replayInto(SpMatDsptr spMat);
+		void atijplusDiagonalMatrix(int i, int j, DiagMatDsptr diagMat) override;
+		void atijminusDiagonalMatrix(int i, int j, DiagMatDsptr diagMat) override;
+		void atijplusFullRow(int i, int j, FRowDsptr fullRow) override;
+		void atijplusFullColumn(int i, int j, FColDsptr fullCol) override;
+		void atijplusFullMatrix(int i, int j, FMatDsptr fullMat) override;
+		void atijminusFullMatrix(int i, int j, FMatDsptr fullMat) override;
+		void atijplusTransposeFullMatrix(int i, int j, FMatDsptr fullMat) override;
+		void atijplusFullMatrixtimes(int i, int j, FMatDsptr fullMat, double factor) override;
+		void atijminusFullColumn(int i, int j, FColDsptr fullCol) override;
+		void atijminusTransposeFullMatrix(int i, int j, FMatDsptr fullMat) override;
+		void atijplusNumber(int i, int j, double value) override;
+		void atijminusNumber(int i, int j, double value) override;
+		void atijput(int i, int j, double value) override;
+		void atijplusArray(int i, int j, int nrow, int ncol, const double* values) override;
+
+	private:
+		double* addWindow(int i, int j, int nrow, int ncol, bool isPut = false);
+
+		std::vector<Window> windows;
+		std::vector<double> values;
+	};
+}
+
@@ -31,6 +31,8 @@ namespace MbD {
 		SparseRow(std::initializer_list<std::initializer_list<T>> list) : SparseVector<T>{ list } {}
 		SpRowDsptr timesconditionedWithTol(double scaling, double tol);
 		SpRowDsptr conditionedWithTol(double tol);
+		template<typename F>
+		void segmentDo(int j, int n, F f);
 		void atiplusFullRow(int j, FRowsptr<T> fullRow);
 		void atiminusFullRow(int j, FRowsptr<T> fullRow);
 		void atiplusFullRowtimes(int j, FRowsptr<T> fullRow, double factor);
@@ -62,28 +64,34 @@ namespace MbD {
 		return answer;
 	}
 	template<typename T>
-	inline void SparseRow<T>::atiplusFullRow(int j, FRowsptr<T> fullRow)
+	template<typename F>
+	inline void SparseRow<T>::segmentDo(int j, int n, F f)
 	{
-		for (int jj = 0; jj < fullRow->size(); jj++)
+		//"Call f(entry, jj) for entries j to j + n - 1, inserting zeros where missing."
+		//"The segment is contiguous in the map, so one search finds its start and the rest is a walk."
+		auto itr = this->lower_bound(j);
+		for (int jj = 0; jj < n; jj++)
 		{
-			(*this)[j + jj] += fullRow->at(jj);
+			auto key = j + jj;
+			if (itr == this->end() || itr->first != key) itr = this->emplace_hint(itr, key, (T)0);
+			f(itr->second, jj);
+			++itr;
 		}
 	}
 	template<typename T>
+	inline void SparseRow<T>::atiplusFullRow(int j, FRowsptr<T> fullRow)
+	{
+		this->segmentDo(j, (int)fullRow->size(), [&](T& entry, int jj) { entry += fullRow->at(jj); });
+	}
+	template<typename T>
 	inline void SparseRow<T>::atiminusFullRow(int j, FRowsptr<T> fullRow)
 	{
-		for (int jj = 0; jj < fullRow->size(); jj++)
-		{
-			(*this)[j + jj] -= fullRow->at(jj);
-		}
+		this->segmentDo(j, (int)fullRow->size(), [&](T& entry, int jj) { entry -= fullRow->at(jj); });
 	}
 	template<typename T>
 	inline void SparseRow<T>::atiplusFullRowtimes(int j, FRowsptr<T> fullRow, double factor)
 	{
-		for (int jj = 0; jj < fullRow->size(); jj++)
-		{
-			(*this)[j + jj] += fullRow->at(jj) * factor;
-		}
+		this->segmentDo(j, (int)fullRow->size(), [&](T& entry, int jj) { entry += fullRow->at(jj) * factor; });
 	}
 	template<typename T>
 	inline T SparseRow<T>::timesFullColumn(FColsptr<T> fullCol)
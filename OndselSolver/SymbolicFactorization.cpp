@@ -0,0 +1,185 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+ 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <queue>
+
+#include "SymbolicFactorization.h"
+
+using namespace MbD;
+
+void SymbolicFactorization::analyze(SpMatDsptr spMat, std::shared_ptr<FullColumn<int>> rowOrder, std::shared_ptr<FillReducingOrdering> ordering)
+{
+	//"Symbolic row by row elimination in pivot order."
+	//"Every stored entry counts, including explicit zeros, so later fills with the same pattern fit."
+	//"Fill in row k from pivot row p is the upper pattern of p. Fill left of k is eliminated later."
+	m = spMat->nrow();
+	n = spMat->ncol();
+	pivotOrder.assign(rowOrder->begin(), rowOrder->end());
+	if (ordering) {
+		colPositions = ordering->colPositions;
+	}
+	else {
+		colPositions.resize(n);
+		for (int j = 0; j < n; j++) colPositions[j] = j;
+	}
+	lowerStarts.assign(m + 1, 0);
+	upperStarts.assign(m + 1, 0);
+	lowerCols.clear();
+	upperCols.clear();
+	std::vector<int> marks(n, -1);
+	std::priority_queue<int, std::vector<int>, std::greater<int>> lowerQueue;
+	for (int k = 0; k < m; k++)
+	{
+		lowerStarts[k] = (int)lowerCols.size();
+		upperStarts[k] = (int)upperCols.size();
+		marks[k] = k;
+		spMat->rowDo(pivotOrder[k], [&](int jj, double) {
+			auto j = colPositions[jj];
+			if (marks[j] == k) return;
+			marks[j] = k;
+			if (j < k) {
+				lowerQueue.push(j);
+			}
+			else {
+				upperCols.push_back(j);
+			}
+			});
+		while (!lowerQueue.empty()) {
+			auto p = lowerQueue.top();
+			lowerQueue.pop();
+			lowerCols.push_back(p);
+			for (int kk = upperStarts[p]; kk < upperStarts[p + 1]; kk++)
+			{
+				auto j = upperCols[kk];
+				if (marks[j] == k) continue;
+				marks[j] = k;
+				if (j < k) {
+					lowerQueue.push(j);
+				}
+				else {
+					upperCols.push_back(j);
+				}
+			}
+		}
+		std::sort(upperCols.begin() + upperStarts[k], upperCols.end());
+	}
+	lowerStarts[m] = (int)lowerCols.size();
+	upperStarts[m] = (int)upperCols.size();
+	hasSupernodes = false;
+	nAnalysis++;
+}
+
+bool SymbolicFactorization::isValidFor(SpMatDsptr spMat)
+{
+	return m > 0 && m == spMat->nrow() && n == spMat->ncol();
+}
+
+void SymbolicFactorization::invalidate()
+{
+	m = -1;
+	n = -1;
+}
+
+void SymbolicFactorization::findSupernodes()
+{
+	//"Row k joins the current supernode while the explicit zeros in its dense upper block stay within relaxedZeroFraction."
+	//"Exactly nested rows, upperCols(k-1) = {k} + upperCols(k), add no zeros."
+	//"The front of a supernode is closed over the upper columns of every earlier supernode updating it, in ascending order."
+	supernodeStarts.assign(1, 0);
+	supernodeOf.assign(m, 0);
+	std::vector<int> unionCols, mergedCols;
+	unionCols.push_back(0);
+	unionCols.insert(unionCols.end(), upperCols.begin() + upperStarts[0], upperCols.begin() + upperStarts[1]);
+	int nEntries = (int)unionCols.size();
+	for (int k = 1; k < m; k++)
+	{
+		auto k0 = supernodeStarts.back();
+		mergedCols.clear();
+		std::vector<int> rowCols(1, k);
+		rowCols.insert(rowCols.end(), upperCols.begin() + upperStarts[k], upperCols.begin() + upperStarts[k + 1]);
+		std::set_union(unionCols.begin(), unionCols.end(), rowCols.begin(), rowCols.end(), std::back_inserter(mergedCols));
+		auto nrow = k - k0 + 1;
+		auto nStored = nrow * (int)mergedCols.size();
+		auto nZeros = nStored - (nEntries + (int)rowCols.size());
+		if (nZeros <= relaxedZeroFraction * nStored) {
+			unionCols.swap(mergedCols);
+			nEntries += (int)rowCols.size();
+		}
+		else {
+			supernodeStarts.push_back(k);
+			unionCols.swap(rowCols);
+			nEntries = (int)unionCols.size();
+		}
+		supernodeOf[k] = (int)supernodeStarts.size() - 1;
+	}
+	supernodeStarts.push_back(m);
+	auto nSupernode = this->numberOfSupernodes();
+	frontStarts.assign(1, 0);
+	frontCols.clear();
+	updateStarts.assign(1, 0);
+	updateSupernodes.clear();
+	std::vector<int> marks(n, -1), supernodeMarks(nSupernode, -1), cols;
+	std::priority_queue<int, std::vector<int>, std::greater<int>> lowerQueue;
+	for (int s = 0; s < nSupernode; s++)
+	{
+		auto k0 = supernodeStarts[s];
+		auto k1 = supernodeStarts[s + 1];
+		cols.clear();
+		auto addCol = [&](int j) {
+			if (marks[j] == s) return;
+			marks[j] = s;
+			cols.push_back(j);
+			if (j < k0) lowerQueue.push(j);
+			};
+		for (int k = k0; k < k1; k++)
+		{
+			for (int kk = lowerStarts[k]; kk < lowerStarts[k + 1]; kk++) addCol(lowerCols[kk]);
+			addCol(k);
+			for (int kk = upperStarts[k]; kk < upperStarts[k + 1]; kk++) addCol(upperCols[kk]);
+		}
+		while (!lowerQueue.empty()) {
+			auto s1 = supernodeOf[lowerQueue.top()];
+			lowerQueue.pop();
+			if (supernodeMarks[s1] == s) continue;
+			supernodeMarks[s1] = s;
+			updateSupernodes.push_back(s1);
+			auto j0 = supernodeStarts[s1];
+			for (int ff = frontStarts[s1]; ff < frontStarts[s1 + 1]; ff++)
+			{
+				auto j = frontCols[ff];
+				if (j >= j0) addCol(j);
+			}
+		}
+		std::sort(cols.begin(), cols.end());
+		frontCols.insert(frontCols.end(), cols.begin(), cols.end());
+		frontStarts.push_back((int)frontCols.size());
+		updateStarts.push_back((int)updateSupernodes.size());
+	}
+	//"dependents inverts updateSupernodes. Together they are the task graph of the elimination."
+	dependentStarts.assign(nSupernode + 1, 0);
+	for (auto s1 : updateSupernodes) dependentStarts[s1 + 1]++;
+	for (int s = 0; s < nSupernode; s++) dependentStarts[s + 1] += dependentStarts[s];
+	dependents.resize(updateSupernodes.size());
+	std::vector<int> nextDependent(dependentStarts.begin(), dependentStarts.end() - 1);
+	for (int s = 0; s < nSupernode; s++)
+	{
+		for (int u = updateStarts[s]; u < updateStarts[s + 1]; u++)
+		{
+			dependents[nextDependent[updateSupernodes[u]]++] = s;
+		}
+	}
+	hasSupernodes = true;
+}
+
+int SymbolicFactorization::numberOfSupernodes()
+{
+	return (int)supernodeStarts.size() - 1;
+}
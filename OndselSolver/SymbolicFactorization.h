@@ -0,0 +1,42 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+ 
+#pragma once
+
+#include <vector>
+
+#include "SparseMatrix.h"
+#include "FillReducingOrdering.h"
+
+namespace MbD {
+    class SymbolicFactorization
+    {
+        //m n pivotOrder colPositions lowerStarts lowerCols upperStarts upperCols nAnalysis nNumeric nFallback 
+        //supernodeStarts supernodeOf frontStarts frontCols updateStarts updateSupernodes dependentStarts dependents hasSupernodes relaxedZeroFraction 
+        //"Pivot sequence and fill pattern of sparse Gauss elimination with row pivoting."
+        //"Row k of the factors is row pivotOrder[k] of the original matrix."
+        //"Column j of the original matrix is column colPositions[j] of the factors."
+        //"Row k holds columns lowerCols (< k) eliminated in ascending order and upperCols (> k)."
+        //"A supernode is a run of rows stored as one dense upper block. Their upper patterns nest, up to relaxedZeroFraction explicit zeros."
+        //"Its front lists every column its rows touch. updateSupernodes are the earlier supernodes that update it."
+    public:
+        void analyze(SpMatDsptr spMat, std::shared_ptr<FullColumn<int>> rowOrder, std::shared_ptr<FillReducingOrdering> ordering);
+        bool isValidFor(SpMatDsptr spMat);
+        void invalidate();
+        void findSupernodes();
+        int numberOfSupernodes();
+
+        int m = -1, n = -1;
+        std::vector<int> pivotOrder, colPositions, lowerStarts, lowerCols, upperStarts, upperCols;
+        std::vector<int> supernodeStarts, supernodeOf, frontStarts, frontCols, updateStarts, updateSupernodes, dependentStarts, dependents;
+        bool hasSupernodes = false;
+        double relaxedZeroFraction = 0.2;
+        int nAnalysis = 0, nNumeric = 0, nFallback = 0;
+    };
+}
+
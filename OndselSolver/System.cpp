@@ -7,6 +7,11 @@
  ***************************************************************************/
  
 #include<algorithm>
+#include <numeric>
+#include <map>
+#include <exception>
+#include <set>
+#include <string>
 
 #include "System.h"
 #include "Part.h"
@@ -17,6 +22,12 @@
 #include "CREATE.h"
 #include "ExternalSystem.h"
 #include "PrescribedMotion.h"
+#include "PartFrame.h"
+#include "MarkerFrame.h"
+#include "WorkStealingPool.h"
+#include "FixedJoint.h"
+#include "EndFrameqct.h"
+#include "RigidCluster.h"
 
 using namespace MbD;
 
@@ -68,6 +79,7 @@ void MbD::System::addForceTorque(std::shared_ptr<ForceTorqueItem> forTor)
 void System::runKINEMATIC(std::shared_ptr<System> self)
 {
 	externalSystem->preMbDrun(self);
+	if (systemSolver->useComponentsAllIC) this->findComponents();
 	while (true)
 	{
 		initializeLocally();
@@ -76,12 +88,342 @@ void System::runKINEMATIC(std::shared_ptr<System> self)
 	}
 	partsJointsMotionsForcesTorquesDo([](std::shared_ptr<Item> item) { item->postInput(); });
 	externalSystem->outputFor(INPUT);
-	systemSolver->runAllIC();
+	this->runAllIC();
 	externalSystem->outputFor(INITIALCONDITION);
 	systemSolver->runBasicKinematic();
 	externalSystem->postMbDrun();
 }
 
+void System::findComponents()
+{
+	//"Parts connected through joints or motions form a component. Fixed parts do not connect them."
+	//"A marker of a fixed part with one end frame connects only the joints at it. When they are in another component"
+	//"than the part, runAllICOfComponents moves the marker to a fixed copy of the part in that component meanwhile."
+	//"Forces go into every component as copies, so all of them must be copyable."
+	components = nullptr;
+	fixedPartCopies.clear();
+	movedMarkerFrames.clear();
+	copyNosOfMovedMarkerFrames.clear();
+	auto nPart = (int)parts->size();
+	if (nPart < 2) return;
+	for (auto& forTor : *forcesTorques) {
+		if (forTor->newCopy() == nullptr) return;
+	}
+	std::map<Part*, int> partNos;
+	for (int i = 0; i < nPart; i++) partNos[parts->at(i).get()] = i;
+	auto partNoOf = [&](EndFrmsptr& frm) {
+		auto it = partNos.find(frm->getMarkerFrame()->getPartFrame()->getPart());
+		return (it == partNos.end()) ? -1 : it->second;
+		};
+	auto isFixed = [&](int i) { return !parts->at(i)->partFrame->aGabs->empty(); };
+	auto isMovable = [](EndFrmsptr& frm) {
+		auto& endFrames = frm->getMarkerFrame()->endFrames;
+		return endFrames->size() == 1 && endFrames->front() == frm;
+		};
+	//"Nodes are the parts followed by the movable markers of fixed parts."
+	std::vector<int> roots(nPart);
+	std::iota(roots.begin(), roots.end(), 0);
+	auto rootOf = [&](int i) {
+		while (roots[i] != i) i = roots[i] = roots[roots[i]];
+		return i;
+		};
+	std::vector<MarkerFrame*> markerFrames;
+	std::vector<int> partNosOfMarkerFrames;
+	std::map<MarkerFrame*, int> markerNodes;
+	std::vector<bool> isConnected(nPart, false);
+	auto nodeOf = [&](int i, int j, EndFrmsptr& frm) {
+		if (!isFixed(i) || isFixed(j) || !isMovable(frm)) {
+			isConnected[i] = true;
+			return i;
+		}
+		auto markerFrame = frm->getMarkerFrame();
+		auto it = markerNodes.find(markerFrame);
+		if (it != markerNodes.end()) return it->second;
+		auto node = (int)roots.size();
+		roots.push_back(node);
+		markerNodes[markerFrame] = node;
+		markerFrames.push_back(markerFrame);
+		partNosOfMarkerFrames.push_back(i);
+		return node;
+		};
+	auto nJoint = (int)jointsMotions->size();
+	std::vector<int> nodesOfJoints(nJoint);	//"The node whose component the joint belongs to."
+	for (int k = 0; k < nJoint; k++)
+	{
+		auto& joint = jointsMotions->at(k);
+		auto i = partNoOf(joint->frmI);
+		auto j = partNoOf(joint->frmJ);
+		if (i < 0 || j < 0) return;
+		auto nodeI = nodeOf(i, j, joint->frmI);
+		auto nodeJ = nodeOf(j, i, joint->frmJ);
+		roots[rootOf(nodeI)] = rootOf(nodeJ);
+		nodesOfJoints[k] = nodeI;
+	}
+	//"A fixed part used only through movable markers goes to the first component that uses it."
+	auto isAdopted = [&](int i) {
+		return isFixed(i) && !isConnected[i]
+			&& std::find(partNosOfMarkerFrames.begin(), partNosOfMarkerFrames.end(), i) != partNosOfMarkerFrames.end();
+		};
+	std::vector<int> componentNos(roots.size(), -1);
+	auto nComponent = 0;
+	for (int i = 0; i < nPart; i++)
+	{
+		if (isAdopted(i)) continue;
+		auto& componentNo = componentNos[rootOf(i)];
+		if (componentNo < 0) componentNo = nComponent++;
+	}
+	if (nComponent < 2) return;
+	components = std::make_shared<std::vector<std::shared_ptr<System>>>();
+	for (int c = 0; c < nComponent; c++)
+	{
+		auto component = std::make_shared<System>();
+		component->parentSystem = this;
+		component->externalSystem = externalSystem;
+		component->time = time;
+		for (auto& forTor : *forcesTorques) component->addForceTorque(forTor->newCopy());
+		components->push_back(component);
+	}
+	std::vector<int> fixedComponentNos(nPart, -1);
+	for (int i = 0; i < nPart; i++)
+	{
+		if (isAdopted(i)) continue;
+		auto c = componentNos[rootOf(i)];
+		components->at(c)->parts->push_back(parts->at(i));
+		fixedComponentNos[i] = c;
+	}
+	for (int k = 0; k < nJoint; k++)
+	{
+		auto c = componentNos[rootOf(nodesOfJoints[k])];
+		components->at(c)->jointsMotions->push_back(jointsMotions->at(k));
+	}
+	std::map<std::pair<int, int>, int> copyNos;
+	for (int m = 0; m < (int)markerFrames.size(); m++)
+	{
+		auto f = partNosOfMarkerFrames[m];
+		auto c = componentNos[rootOf(nPart + m)];
+		auto& component = components->at(c);
+		if (fixedComponentNos[f] < 0) {
+			fixedComponentNos[f] = c;
+			component->parts->push_back(parts->at(f));
+		}
+		if (fixedComponentNos[f] == c) continue;
+		auto it = copyNos.find({ f, c });
+		if (it == copyNos.end()) {
+			auto partCopy = parts->at(f)->newFixedCopy();
+			partCopy->setSystem(this);
+			component->parts->push_back(partCopy);
+			it = copyNos.insert({ { f, c }, (int)fixedPartCopies.size() }).first;
+			fixedPartCopies.push_back(partCopy);
+		}
+		auto& partMarkerFrames = *parts->at(f)->partFrame->markerFrames;
+		auto markerFrame = std::find_if(partMarkerFrames.begin(), partMarkerFrames.end(), [&](auto& mkr) {
+			return mkr.get() == markerFrames[m];
+			});
+		movedMarkerFrames.push_back(*markerFrame);
+		copyNosOfMovedMarkerFrames.push_back(it->second);
+	}
+	//"Largest first so that the pool is not left waiting on one large component."
+	std::stable_sort(components->begin(), components->end(), [](auto& a, auto& b) {
+		return a->parts->size() > b->parts->size();
+		});
+	for (int c = 0; c < nComponent; c++) components->at(c)->name = "Component" + std::to_string(c + 1);
+}
+
+void System::runAllIC()
+{
+	if (components == nullptr) {
+		systemSolver->runAllIC();
+		return;
+	}
+	this->runAllICOfComponents();
+}
+
+void System::runAllICOfComponents()
+{
+	//"Each component has a new SystemSolver with the settings of systemSolver and its own equation numbers and caches."
+	//"The components own their items meanwhile. They run concurrently on the parallelPool of systemSolver, each on one thread."
+	//"Moved markers go back to their parts afterwards. The kinematic run that follows is on the whole system as input."
+	systemSolver->initializeLocally();
+	systemSolver->initializeGlobally();
+	for (auto& partCopy : fixedPartCopies) {
+		partCopy->initializeLocally();
+		partCopy->initializeGlobally();
+		partCopy->postInput();
+	}
+	auto nMoved = (int)movedMarkerFrames.size();
+	std::vector<PartFrame*> partFrames(nMoved);
+	std::map<PartFrame*, std::shared_ptr<std::vector<std::shared_ptr<MarkerFrame>>>> markerFrameLists;	//"As input."
+	for (int m = 0; m < nMoved; m++)
+	{
+		auto& markerFrame = movedMarkerFrames[m];
+		auto partFrame = markerFrame->getPartFrame();
+		auto& markerFrameList = markerFrameLists[partFrame];
+		if (markerFrameList == nullptr) {
+			markerFrameList = partFrame->markerFrames;
+			partFrame->markerFrames = std::make_shared<std::vector<std::shared_ptr<MarkerFrame>>>(*markerFrameList);
+		}
+		auto& partMarkerFrames = *partFrame->markerFrames;
+		partMarkerFrames.erase(std::remove(partMarkerFrames.begin(), partMarkerFrames.end(), markerFrame), partMarkerFrames.end());
+		partFrames[m] = partFrame;
+		fixedPartCopies[copyNosOfMovedMarkerFrames[m]]->partFrame->addMarkerFrame(markerFrame);
+	}
+	for (auto& component : *components) {
+		auto solver = systemSolver->newSolverFor(component.get());
+		solver->nThreads = 1;
+		solver->useComponentsAllIC = false;
+		component->systemSolver = solver;
+		component->adoptPartsJointsMotions();
+	}
+	auto nComponent = (int)components->size();
+	std::vector<std::exception_ptr> errors(nComponent);
+	auto runComponent = [&](int c) {
+		try {
+			components->at(c)->systemSolver->runAllIC();
+		}
+		catch (...) {
+			errors[c] = std::current_exception();
+		}
+		};
+	auto pool = systemSolver->parallelPool();
+	if (pool) {
+		for (int c = 0; c < nComponent; c++) pool->submit(0, [&, c](int /*worker*/) { runComponent(c); });
+		pool->wait();
+	}
+	else {
+		for (int c = 0; c < nComponent; c++) runComponent(c);
+	}
+	for (int m = 0; m < nMoved; m++) movedMarkerFrames[m]->setPartFrame(partFrames[m]);
+	for (auto& partCopy : fixedPartCopies) partCopy->partFrame->markerFrames->clear();
+	for (auto it = markerFrameLists.begin(); it != markerFrameLists.end(); it++) it->first->markerFrames = it->second;
+	this->adoptPartsJointsMotions();
+	for (auto& error : errors) {
+		if (error) std::rethrow_exception(error);
+	}
+}
+
+void System::adoptPartsJointsMotions()
+{
+	for (auto& part : *parts) part->setSystem(this);
+	for (auto& joint : *jointsMotions) joint->owner = this;
+}
+
+std::shared_ptr<std::vector<std::shared_ptr<RigidCluster>>> System::rigidClusters()
+{
+	//"Parts joined by fixed joints form a rigid cluster. End frames with motion do not join them."
+	//"Two fixed parts are not joined. A fixed joint closing a loop in a cluster belongs to it."
+	auto clusters = std::make_shared<std::vector<std::shared_ptr<RigidCluster>>>();
+	auto nPart = (int)parts->size();
+	std::map<Part*, int> partNos;
+	for (int i = 0; i < nPart; i++) partNos[parts->at(i).get()] = i;
+	auto partNoOf = [&](EndFrmsptr& frm) {
+		auto it = partNos.find(frm->getMarkerFrame()->getPartFrame()->getPart());
+		return (it == partNos.end()) ? -1 : it->second;
+		};
+	auto isRigid = [](std::shared_ptr<Joint>& joint) {
+		return std::dynamic_pointer_cast<FixedJoint>(joint)
+			&& !std::dynamic_pointer_cast<EndFrameqct>(joint->frmI)
+			&& !std::dynamic_pointer_cast<EndFrameqct>(joint->frmJ);
+		};
+	std::vector<int> roots(nPart);
+	std::iota(roots.begin(), roots.end(), 0);
+	auto rootOf = [&](int i) {
+		while (roots[i] != i) i = roots[i] = roots[roots[i]];
+		return i;
+		};
+	std::vector<bool> hasFixedPart(nPart);
+	for (int i = 0; i < nPart; i++) hasFixedPart[i] = RigidCluster::isFixed(parts->at(i));
+	auto nJoint = (int)jointsMotions->size();
+	std::vector<bool> isClustered(nJoint, false);
+	for (int k = 0; k < nJoint; k++)
+	{
+		auto& joint = jointsMotions->at(k);
+		if (!isRigid(joint)) continue;
+		auto i = partNoOf(joint->frmI);
+		auto j = partNoOf(joint->frmJ);
+		if (i < 0 || j < 0) continue;
+		auto rooti = rootOf(i);
+		auto rootj = rootOf(j);
+		if (rooti != rootj) {
+			if (hasFixedPart[rooti] && hasFixedPart[rootj]) continue;
+			roots[rooti] = rootj;
+			hasFixedPart[rootj] = hasFixedPart[rootj] || hasFixedPart[rooti];
+		}
+		isClustered[k] = true;
+	}
+	std::vector<int> clusterNos(nPart, -1);
+	for (int k = 0; k < nJoint; k++)
+	{
+		if (!isClustered[k]) continue;
+		auto& joint = jointsMotions->at(k);
+		auto& clusterNo = clusterNos[rootOf(partNoOf(joint->frmI))];
+		if (clusterNo < 0) {
+			clusterNo = (int)clusters->size();
+			clusters->push_back(std::make_shared<RigidCluster>());
+		}
+		clusters->at(clusterNo)->fixedJoints.push_back(joint);
+	}
+	for (int i = 0; i < nPart; i++)
+	{
+		auto clusterNo = clusterNos[rootOf(i)];
+		if (clusterNo >= 0) clusters->at(clusterNo)->parts.push_back(parts->at(i));
+	}
+	return clusters;
+}
+
+void System::runPosICOfRigidClusters()
+{
+	//"Assemble with each rigid cluster as one body first, on a system without the fixed joints of the clusters."
+	//"Its new SystemSolver has the settings and the pool of systemSolver. The parts of the clusters are then placed from their bodies."
+	//"Redundant constraints are reactivated, so that position IC of the whole system finds them again."
+	auto clusters = this->rigidClusters();
+	if (clusters->empty()) return;
+	auto reducedSystem = std::make_shared<System>();
+	reducedSystem->externalSystem = externalSystem;
+	reducedSystem->time = time;
+	std::set<Part*> clusteredParts;
+	std::set<Joint*> clusteredJoints;
+	for (auto& cluster : *clusters) {
+		cluster->calcBody();
+		reducedSystem->parts->push_back(cluster->body);
+		for (auto& part : cluster->parts) clusteredParts.insert(part.get());
+		for (auto& joint : cluster->fixedJoints) clusteredJoints.insert(joint.get());
+	}
+	for (auto& part : *parts) {
+		if (clusteredParts.count(part.get()) == 0) reducedSystem->parts->push_back(part);
+	}
+	for (auto& joint : *jointsMotions) {
+		if (clusteredJoints.count(joint.get()) == 0) reducedSystem->jointsMotions->push_back(joint);
+	}
+	auto solver = systemSolver->newSolverFor(reducedSystem.get());
+	solver->useRigidClustersPosIC = false;
+	solver->workStealingPool = systemSolver->parallelPool();
+	solver->initializeLocally();
+	reducedSystem->systemSolver = solver;
+	reducedSystem->adoptPartsJointsMotions();
+	for (auto& cluster : *clusters) cluster->moveMarkersToBody();
+	auto restore = [&]() {
+		reducedSystem->partsJointsMotionsDo([](std::shared_ptr<Item> item) { item->reactivateRedundantConstraints(); });
+		for (auto& cluster : *clusters) cluster->restoreMarkers();
+		this->adoptPartsJointsMotions();
+		};
+	try {
+		solver->runPosIC();
+		while (solver->needToRedoPosIC())
+		{
+			solver->runPosIC();
+		}
+	}
+	catch (...) {
+		//"Position IC of the whole system starts from the original positions instead."
+		restore();
+		std::string str("MbD: Assembly of rigid clusters failed. Position IC starts from the original positions.");
+		this->logString(str);
+		return;
+	}
+	restore();
+	for (auto& cluster : *clusters) cluster->setPartsFromBody();
+}
+
 void System::initializeLocally()
 {
 	hasChanged = false;
@@ -129,6 +471,13 @@ void System::partsJointsMotionsForcesTorquesDo(const std::function<void(std::sha
 
 void System::logString(std::string& str)
 {
+	//"Components log through their parent, one line at a time, tagged with their name."
+	if (parentSystem) {
+		auto tagged = name + ": " + str;
+		parentSystem->logString(tagged);
+		return;
+	}
+	std::lock_guard<std::mutex> lock(logMutex);
 	externalSystem->logString(str);
 }
 
@@ -179,12 +528,14 @@ std::shared_ptr<std::vector<std::shared_ptr<Constraint>>> System::allConstraints
 
 double System::maximumMass()
 {
+	if (parentSystem) return parentSystem->maximumMass();
 	auto maxPart = std::max_element(parts->begin(), parts->end(), [](auto& a, auto& b) { return a->m < b->m; });
 	return maxPart->get()->m;
 }
 
 double System::maximumMomentOfInertia()
 {
+	if (parentSystem) return parentSystem->maximumMomentOfInertia();
 	double max = 0.0;
 	for (int i = 0; i < parts->size(); i++)
 	{
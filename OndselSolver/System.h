@@ -19,6 +19,7 @@
 #include <memory>
 #include <vector>
 #include <functional>
+#include <mutex>
 
 #include "Item.h"
 
@@ -31,6 +32,8 @@ namespace MbD {
 	class PrescribedMotion;
 	class ForceTorqueItem;
 	class ExternalSystem;
+	class RigidCluster;
+	class MarkerFrame;
 
 	class System : public Item
 	{
@@ -44,6 +47,12 @@ namespace MbD {
 		void initializeGlobally() override;
 		void clear();
 		void runKINEMATIC(std::shared_ptr<System> self);
+		void findComponents();
+		void runAllIC();
+		void runAllICOfComponents();
+		void adoptPartsJointsMotions();
+		std::shared_ptr<std::vector<std::shared_ptr<RigidCluster>>> rigidClusters();
+		void runPosICOfRigidClusters();
 		std::shared_ptr<std::vector<std::string>> discontinuitiesAtIC();
 		void jointsMotionsDo(const std::function <void(std::shared_ptr<Joint>)>& f);
 		void partsJointsMotionsDo(const std::function <void(std::shared_ptr<Item>)>& f);
@@ -72,7 +81,14 @@ namespace MbD {
 		std::shared_ptr<std::vector<std::shared_ptr<Joint>>> jointsMotions;
 		std::shared_ptr<std::vector<std::shared_ptr<ForceTorqueItem>>> forcesTorques;
 		bool hasChanged = false;
+		DerivativeDemand derivativeDemand = SECONDDERIVATIVES;	//Highest q derivatives the current solver phase uses. Set by SystemSolver.
 		std::shared_ptr<SystemSolver> systemSolver;
+		std::shared_ptr<std::vector<std::shared_ptr<System>>> components;	//Mechanisms not connected to each other, assembled separately. Null when there is only one.
+		std::vector<std::shared_ptr<Part>> fixedPartCopies;	//Fixed copies of fixed parts in components without the parts.
+		std::vector<std::shared_ptr<MarkerFrame>> movedMarkerFrames;	//Markers of fixed parts on fixedPartCopies while the components run.
+		std::vector<int> copyNosOfMovedMarkerFrames;
+		System* parentSystem = nullptr; //Use raw pointer when pointing backwards.
+		std::mutex logMutex;	//Concurrent components log one line at a time.
 
 		std::shared_ptr<Time> time;
 	};
@@ -9,10 +9,16 @@
 #include "SystemNewtonRaphson.h"
 #include "SystemSolver.h"
 #include "SparseMatrix.h"
+#include "BlockSparseMatrix.h"
+#include "Part.h"
 #include "MatrixSolver.h"
 #include "GESpMatParPvMarkoFast.h"
+#include "GESpMatParPvSupernodal.h"
 #include "CREATE.h"
 #include "GESpMatParPvPrecise.h"
+#include "FillReducingOrdering.h"
+#include "GMRESSpMatILU.h"
+#include "GESpMatParPvBlockTriangular.h"
 
 using namespace MbD;
 
@@ -28,12 +34,59 @@ void SystemNewtonRaphson::createVectorsAndMatrices()
 {
 	x = std::make_shared<FullColumn<double>>(n);
 	y = std::make_shared<FullColumn<double>>(n);
-	pypx = std::make_shared <SparseMatrix<double>>(n, n);
+	minusY = std::make_shared<FullColumn<double>>(n);
+	pypx = system->jacobianFor(this, this->blockStarts());
+}
+
+std::vector<int> SystemNewtonRaphson::blockStarts()
+{
+	//"Each part contributes a qX block of 3 and a qE block of 4. Other equations are single rows."
+	std::vector<std::pair<int, int>> startsAndSizes;
+	for (auto& part : *(system->parts())) {
+		startsAndSizes.push_back({ part->iqX(), 3 });
+		startsAndSizes.push_back({ part->iqE(), 4 });
+	}
+	return BlockSparseMatrix<double>::blockStartsFor(n, startsAndSizes);
 }
 
 std::shared_ptr<MatrixSolver> SystemNewtonRaphson::matrixSolverClassNew()
 {
-	return CREATE<GESpMatParPvMarkoFast>::With();
+	//"Phases set to use the Krylov solver iterate instead of eliminating."
+	if (this->usesKrylovSolver()) return CREATE<GMRESSpMatILU>::With();
+	return this->eliminationSolverNew();
+}
+
+std::shared_ptr<MatrixSolver> SystemNewtonRaphson::eliminationSolverNew()
+{
+	//"Large systems refactor by supernode with dense kernels."
+	std::shared_ptr<GESpMatParPvMarkoFast> matSolver;
+	if (n >= system->supernodalSolverThreshold) {
+		auto supernodal = CREATE<GESpMatParPvSupernodal>::With();
+		supernodal->workStealingPool = system->parallelPool();
+		matSolver = supernodal;
+	}
+	else {
+		matSolver = CREATE<GESpMatParPvMarkoFast>::With();
+	}
+	matSolver->symbolicFactorization = system->symbolicFactorizationFor(this);
+	matSolver->fillReducingOrdering = system->fillReducingOrderingFor(this);
+	if (!this->usesBlockTriangularForm()) return matSolver;
+	//"Assemblies often solve part by part, or loop by loop. Patterns of a single block go to matSolver whole."
+	auto blockSolver = CREATE<GESpMatParPvBlockTriangular>::With();
+	blockSolver->blockTriangularForm = system->blockTriangularFormFor(this);
+	blockSolver->wholeMatrixSolver = matSolver;
+	blockSolver->fillReducingOrdering = matSolver->fillReducingOrdering;
+	return blockSolver;
+}
+
+bool SystemNewtonRaphson::usesKrylovSolver()
+{
+	return false;
+}
+
+bool SystemNewtonRaphson::usesBlockTriangularForm()
+{
+	return false;
 }
 
 void SystemNewtonRaphson::calcdxNorm()
@@ -46,26 +99,85 @@ void SystemNewtonRaphson::calcdxNorm()
 
 void SystemNewtonRaphson::basicSolveEquations()
 {
-	dx = matrixSolver->solvewithsaveOriginal(pypx, y->negated(), false);
+	matrixSolver->relativeTolerance = this->linearSolveTolerance();
+	matrixSolver->scratchResource = iterationArena.resource();
+	y->negatedInto(minusY);
+	dx = matrixSolver->solvewithsaveOriginal(pypx, minusY, false);
+	if (this->usesBroydenUpdates()) {
+		//"A new Jacobian after Broyden steps were started means they were given up."
+		if (!broydenSteps.empty()) nBroydenFallback++;
+		broydenSteps.clear();
+		broydenSteps.push_back(dx);
+	}
+	auto& ordering = matrixSolver->fillReducingOrdering;
+	if (ordering && !ordering->fillReported) {
+		auto str = ordering->fillReport();
+		system->logString(str);
+	}
+	auto blockSolver = std::dynamic_pointer_cast<GESpMatParPvBlockTriangular>(matrixSolver);
+	if (blockSolver && !blockSolver->blockTriangularForm->reported) {
+		auto str = blockSolver->blockTriangularForm->blockReport();
+		system->logString(str);
+	}
+}
+
+bool SystemNewtonRaphson::solveEquationsWithLastJacobian()
+{
+	//"pypx is left as last filled. The factors stand for it."
+	if (!matrixSolver->hasReusableFactorsOfOrder(n)) return false;
+	y->negatedInto(minusY);
+	dx = matrixSolver->solveWithFactors(minusY);
+	if (!this->usesBroydenUpdates()) return true;
+	return this->updateBroydenStep();
+}
+
+bool SystemNewtonRaphson::updateBroydenStep()
+{
+	//"Broyden's good update of the factored Jacobian, applied to dx as in Kelley's brsol."
+	//"The rank one updates are never formed. Each stored step in turn corrects the step from the factors."
+	//"Steps must be taken in full, so line search is not used with it."
+	//"A small denominator or a full store gives up the updates for a new Jacobian."
+	constexpr auto denominatorMin = 0.1;
+	constexpr int nStepMax = 10;
+	auto nStep = (int)broydenSteps.size();
+	if (nStep == 0 || nStep >= nStepMax) return false;
+	for (int j = 0; j < nStep; j++)
+	{
+		auto& sj = broydenSteps[j];
+		auto sjsq = sj->sumOfSquares();
+		if (sjsq == 0.0) return false;
+		auto sjdx = sj->dot(dx) / sjsq;
+		if (j == nStep - 1) {
+			auto denominator = 1.0 - sjdx;
+			if (std::abs(denominator) < denominatorMin) return false;
+			dx->magnifySelf(1.0 / denominator);
+		}
+		else {
+			dx->equalSelfPlusFullColumntimes(broydenSteps[j + 1], sjdx);
+		}
+	}
+	broydenSteps.push_back(dx);
+	nBroydenUpdate++;
+	return true;
+}
+
+void SystemNewtonRaphson::reportStats()
+{
+	NewtonRaphson::reportStats();
+	if (!this->usesBroydenUpdates()) return;
+	std::string str = "MbD: Broyden updates = " + std::to_string(nBroydenUpdate) + ", fallbacks = " + std::to_string(nBroydenFallback) + ".";
+	system->logString(str);
 }
 
 void SystemNewtonRaphson::handleSingularMatrix()
 {
-    auto& r = *matrixSolver;
-	std::string str = typeid(r).name();
-	if (str.find("GESpMatParPvMarkoFast") != std::string::npos) {
+	if (!matrixSolver->isPrecise()) {
 		matrixSolver = CREATE<GESpMatParPvPrecise>::With();
 		this->solveEquations();
 	}
 	else {
-		str = typeid(r).name();
-		if (str.find("GESpMatParPvPrecise") != std::string::npos) {
-			str = "MbD: Singular Matrix Error. ";
-			system->logString(str);
-			matrixSolver = this->matrixSolverClassNew();
-		}
-		else {
-			assert(false);
-		}
+		std::string str = "MbD: Singular Matrix Error. ";
+		system->logString(str);
+		matrixSolver = this->matrixSolverClassNew();
 	}
 }
@@ -16,17 +16,27 @@ namespace MbD {
 
     class SystemNewtonRaphson : public VectorNewtonRaphson
     {
-        //
+        //pypx minusY broydenSteps nBroydenUpdate nBroydenFallback 
     public:
         void initializeGlobally() override;
         virtual void assignEquationNumbers() override = 0;
         virtual void createVectorsAndMatrices();
+        std::vector<int> blockStarts();
         std::shared_ptr<MatrixSolver> matrixSolverClassNew() override;
+        std::shared_ptr<MatrixSolver> eliminationSolverNew();
+        virtual bool usesKrylovSolver();
+        virtual bool usesBlockTriangularForm();
         void calcdxNorm() override;
         void basicSolveEquations() override;
+        bool solveEquationsWithLastJacobian() override;
+        bool updateBroydenStep();
+        void reportStats() override;
         void handleSingularMatrix() override;
 
         SpMatDsptr pypx;
+        FColDsptr minusY;	//Right hand side of the solve. Refilled from y each iteration.
+        std::vector<FColDsptr> broydenSteps;	//Steps since the last factorization when usesBroydenUpdates. The first is its Newton step.
+        int nBroydenUpdate = 0, nBroydenFallback = 0;
     };
 }
 
@@ -28,6 +28,12 @@
 #include "AccKineNewtonRaphson.h"
 #include "VelICKineSolver.h"
 #include "AccICKineNewtonRaphson.h"
+#include "SymbolicFactorization.h"
+#include "FillReducingOrdering.h"
+#include "BlockTriangularForm.h"
+#include "WorkStealingPool.h"
+#include "ParallelItems.h"
+#include "BlockSparseMatrix.h"
 
 using namespace MbD;
 
@@ -39,6 +45,57 @@ void SystemSolver::setSystem(Solver* sys)
 	assert(false);
 }
 
+std::shared_ptr<SystemSolver> SystemSolver::newSolverFor(System* sys)
+{
+	//"A SystemSolver for sys with the settings of the receiver."
+	//"Caches, pools, integrators and results are its own, so that it may run beside the receiver."
+	auto solver = std::make_shared<SystemSolver>(sys);
+	solver->errorTolPosKine = errorTolPosKine;
+	solver->errorTolAccKine = errorTolAccKine;
+	solver->iterMaxPosKine = iterMaxPosKine;
+	solver->iterMaxAccKine = iterMaxAccKine;
+	solver->tstart = tstart;
+	solver->tend = tend;
+	solver->hmin = hmin;
+	solver->hmax = hmax;
+	solver->hout = hout;
+	solver->corAbsTol = corAbsTol;
+	solver->corRelTol = corRelTol;
+	solver->intAbsTol = intAbsTol;
+	solver->intRelTol = intRelTol;
+	solver->iterMaxDyn = iterMaxDyn;
+	solver->orderMax = orderMax;
+	solver->translationLimit = translationLimit;
+	solver->rotationLimit = rotationLimit;
+	solver->reuseSymbolicFactorization = reuseSymbolicFactorization;
+	solver->useFillReducingOrdering = useFillReducingOrdering;
+	solver->useBlockTriangularFormPosIC = useBlockTriangularFormPosIC;
+	solver->useBlockTriangularFormPosKine = useBlockTriangularFormPosKine;
+	solver->supernodalSolverThreshold = supernodalSolverThreshold;
+	solver->jacobianReuseRatioPosIC = jacobianReuseRatioPosIC;
+	solver->jacobianReuseRatioPosKine = jacobianReuseRatioPosKine;
+	solver->useBroydenUpdatesAccIC = useBroydenUpdatesAccIC;
+	solver->useBroydenUpdatesAccKine = useBroydenUpdatesAccKine;
+	solver->useLineSearchPosIC = useLineSearchPosIC;
+	solver->useLineSearchPosKine = useLineSearchPosKine;
+	solver->useMovedPartsOnlyPosIC = useMovedPartsOnlyPosIC;
+	solver->useMovedPartsOnlyPosKine = useMovedPartsOnlyPosKine;
+	solver->useHomotopyPosIC = useHomotopyPosIC;
+	solver->homotopyFirstIncrementPosIC = homotopyFirstIncrementPosIC;
+	solver->homotopyIncrementMaxPosIC = homotopyIncrementMaxPosIC;
+	solver->useKrylovSolverPosIC = useKrylovSolverPosIC;
+	solver->useKrylovSolverPosKine = useKrylovSolverPosKine;
+	solver->useKrylovSolverVelKine = useKrylovSolverVelKine;
+	solver->useKrylovSolverAccKine = useKrylovSolverAccKine;
+	solver->nThreads = nThreads;
+	solver->useComponentsAllIC = useComponentsAllIC;
+	solver->useRigidClustersPosIC = useRigidClustersPosIC;
+	solver->parallelItemsMin = parallelItemsMin;
+	solver->usePredictorKine = usePredictorKine;
+	solver->reuseKineFactorization = reuseKineFactorization;
+	return solver;
+}
+
 void SystemSolver::initialize()
 {
 	tstartPasts = std::make_shared<std::vector<double>>();
@@ -47,6 +104,11 @@ void SystemSolver::initialize()
 void SystemSolver::initializeLocally()
 {
 	setsOfRedundantConstraints = std::make_shared<std::vector<std::shared_ptr<std::set<std::string>>>>();
+	symbolicFactorizations.clear();
+	fillReducingOrderings.clear();
+	blockTriangularForms.clear();
+	jacobians.clear();
+	kineFactorization = nullptr;
 	direction = (tstart < tend) ? 1.0 : -1.0;
 	toutFirst = tstart + (direction * hout);
 }
@@ -61,6 +123,7 @@ void SystemSolver::runAllIC()
 	{
 		initializeLocally();
 		initializeGlobally();
+		if (useRigidClustersPosIC) system->runPosICOfRigidClusters();
 		runPosIC();
 		while (needToRedoPosIC())
 		{
@@ -81,6 +144,7 @@ void SystemSolver::runAllIC()
 
 void SystemSolver::runPosIC()
 {
+	system->derivativeDemand = LAMWEIGHTEDSECONDDERIVATIVES;
 	icTypeSolver = CREATE<PosICNewtonRaphson>::With();
 	icTypeSolver->setSystem(this);
 	icTypeSolver->run();
@@ -88,6 +152,7 @@ void SystemSolver::runPosIC()
 
 void SystemSolver::runVelIC()
 {
+	system->derivativeDemand = FIRSTDERIVATIVES;
 	icTypeSolver = CREATE<VelICSolver>::With();
 	icTypeSolver->setSystem(this);
 	icTypeSolver->run();
@@ -95,6 +160,7 @@ void SystemSolver::runVelIC()
 
 void SystemSolver::runAccIC()
 {
+	system->derivativeDemand = SECONDDERIVATIVES;
 	icTypeSolver = CREATE<AccICNewtonRaphson>::With();
 	icTypeSolver->setSystem(this);
 	icTypeSolver->run();
@@ -178,6 +244,7 @@ void SystemSolver::runQuasiKinematic()
 
 void SystemSolver::runPosKine()
 {
+	system->derivativeDemand = FIRSTDERIVATIVES;
 	icTypeSolver = CREATE<PosKineNewtonRaphson>::With();
 	icTypeSolver->setSystem(this);
 	icTypeSolver->run();
@@ -185,6 +252,7 @@ void SystemSolver::runPosKine()
 
 void SystemSolver::runVelKine()
 {
+	system->derivativeDemand = FIRSTDERIVATIVES;
 	icTypeSolver = CREATE<VelKineSolver>::With();
 	icTypeSolver->setSystem(this);
 	icTypeSolver->run();
@@ -192,6 +260,7 @@ void SystemSolver::runVelKine()
 
 void SystemSolver::runAccKine()
 {
+	system->derivativeDemand = SECONDDERIVATIVES;
 	icTypeSolver = CREATE<AccKineNewtonRaphson>::With();
 	icTypeSolver->setSystem(this);
 	icTypeSolver->run();
@@ -199,6 +268,7 @@ void SystemSolver::runAccKine()
 
 void SystemSolver::runPosICKine()
 {
+	system->derivativeDemand = LAMWEIGHTEDSECONDDERIVATIVES;
 	icTypeSolver = CREATE<PosICKineNewtonRaphson>::With();
 	icTypeSolver->setSystem(this);
 	icTypeSolver->run();
@@ -206,6 +276,7 @@ void SystemSolver::runPosICKine()
 
 void SystemSolver::runVelICKine()
 {
+	system->derivativeDemand = FIRSTDERIVATIVES;
 	icTypeSolver = CREATE<VelICKineSolver>::With();
 	icTypeSolver->setSystem(this);
 	icTypeSolver->run();
@@ -213,6 +284,7 @@ void SystemSolver::runVelICKine()
 
 void SystemSolver::runAccICKine()
 {
+	system->derivativeDemand = SECONDDERIVATIVES;
 	icTypeSolver = CREATE<AccICKineNewtonRaphson>::With();
 	icTypeSolver->setSystem(this);
 	icTypeSolver->run();
@@ -223,6 +295,37 @@ void SystemSolver::partsJointsMotionsDo(const std::function<void(std::shared_ptr
 	system->partsJointsMotionsDo(f);
 }
 
+void SystemSolver::partsJointsMotionsConcurrentlyDo(const std::function<void(std::shared_ptr<Item>)>& f)
+{
+	//"Parts first, then joints and motions. Items of either kind do not touch each other."
+	auto pool = this->parallelItemsPool();
+	if (pool == nullptr) {
+		system->partsJointsMotionsDo(f);
+		return;
+	}
+	parallelItems->updateDo(pool, system, f);
+}
+
+void SystemSolver::partsJointsMotionsFillColumn(FColDsptr col, const std::function<void(std::shared_ptr<Item>, FColDsptr)>& f)
+{
+	auto pool = this->parallelItemsPool();
+	if (pool == nullptr) {
+		system->partsJointsMotionsDo([&](std::shared_ptr<Item> item) { f(item, col); });
+		return;
+	}
+	parallelItems->fillColumnDo(pool, system, col, f);
+}
+
+void SystemSolver::partsJointsMotionsFillMatrix(SpMatDsptr mat, const std::function<void(std::shared_ptr<Item>, SpMatDsptr)>& f)
+{
+	auto pool = this->parallelItemsPool();
+	if (pool == nullptr) {
+		system->partsJointsMotionsDo([&](std::shared_ptr<Item> item) { f(item, mat); });
+		return;
+	}
+	parallelItems->fillMatrixDo(pool, system, mat, f);
+}
+
 void SystemSolver::logString(std::string& str)
 {
 	system->logString(str);
@@ -308,6 +411,72 @@ void SystemSolver::settime(double tnew)
 	system->mbdTimeValue(tnew);
 }
 
+std::shared_ptr<SymbolicFactorization> SystemSolver::symbolicFactorizationFor(Solver* solver)
+{
+	//"One pivot sequence and fill pattern per solver class. Kept across iterations and time steps."
+	if (!reuseSymbolicFactorization) return nullptr;
+	auto& r = *solver;
+	std::string key = typeid(r).name();
+	auto& symbolic = symbolicFactorizations[key];
+	if (symbolic == nullptr) symbolic = std::make_shared<SymbolicFactorization>();
+	return symbolic;
+}
+
+std::shared_ptr<WorkStealingPool> SystemSolver::parallelPool()
+{
+	//"The pool persists across solves and is rebuilt only when nThreads changes."
+	if (nThreads <= 1) return nullptr;
+	if (workStealingPool == nullptr || workStealingPool->numberOfWorkers() != nThreads) {
+		workStealingPool = std::make_shared<WorkStealingPool>(nThreads);
+	}
+	return workStealingPool;
+}
+
+std::shared_ptr<WorkStealingPool> SystemSolver::parallelItemsPool()
+{
+	//"Few items are quicker on the calling thread than handed to workers."
+	auto nItem = (int)(system->parts->size() + system->jointsMotions->size());
+	if (nItem < parallelItemsMin) return nullptr;
+	auto pool = this->parallelPool();
+	if (pool && parallelItems == nullptr) parallelItems = std::make_shared<ParallelItems>();
+	return pool;
+}
+
+std::shared_ptr<FillReducingOrdering> SystemSolver::fillReducingOrderingFor(Solver* solver)
+{
+	//"One column pre-ordering per solver class. Computed at the first solve and kept while the topology holds."
+	if (!useFillReducingOrdering) return nullptr;
+	auto& r = *solver;
+	std::string key = typeid(r).name();
+	auto& ordering = fillReducingOrderings[key];
+	if (ordering == nullptr) ordering = std::make_shared<FillReducingOrdering>();
+	return ordering;
+}
+
+std::shared_ptr<BlockTriangularForm> SystemSolver::blockTriangularFormFor(Solver* solver)
+{
+	//"One structural analysis per solver class. Kept while the pattern of its Jacobian fits."
+	auto& r = *solver;
+	std::string key = typeid(r).name();
+	auto& form = blockTriangularForms[key];
+	if (form == nullptr) form = std::make_shared<BlockTriangularForm>();
+	return form;
+}
+
+std::shared_ptr<BlockSparseMatrix<double>> SystemSolver::jacobianFor(Solver* solver, const std::vector<int>& blockStarts)
+{
+	//"One Jacobian per solver class, reused while its blocks are unchanged."
+	//"Its compressed pattern and scatter map then carry over to the next time step."
+	auto& r = *solver;
+	std::string key = typeid(r).name();
+	auto& jacobian = jacobians[key];
+	if (jacobian == nullptr || jacobian->rowBlockStarts != blockStarts) {
+		auto n = blockStarts.back();
+		jacobian = std::make_shared<BlockSparseMatrix<double>>(n, n, blockStarts, blockStarts);
+	}
+	return jacobian;
+}
+
 void SystemSolver::tstartPastsAddFirst(double tstartPast)
 {
 	tstartPasts->insert(tstartPasts->begin(), tstartPast);
@@ -12,6 +12,7 @@
 #include <vector>
 #include <functional> 
 #include <set> 
+#include <map> 
 
 #include "Solver.h"
 #include "System.h"
@@ -25,6 +26,14 @@ namespace MbD {
 	class Constraint;
 	class Solver;
 	class QuasiIntegrator;
+	class SymbolicFactorization;
+	class FillReducingOrdering;
+	class BlockTriangularForm;
+	class WorkStealingPool;
+	class ParallelItems;
+	class MatrixSolver;
+	template<typename T>
+	class BlockSparseMatrix;
 
 	class SystemSolver : public Solver
 	{
@@ -36,6 +45,7 @@ namespace MbD {
 			initialize();
 		}
 		void setSystem(Solver* sys) override;
+		std::shared_ptr<SystemSolver> newSolverFor(System* sys);
 		void initialize() override;
 		void initializeLocally() override;
 		void initializeGlobally() override;
@@ -56,6 +66,9 @@ namespace MbD {
 		void runVelICKine();
 		void runAccICKine();
 		void partsJointsMotionsDo(const std::function <void(std::shared_ptr<Item>)>& f);
+		void partsJointsMotionsConcurrentlyDo(const std::function <void(std::shared_ptr<Item>)>& f);
+		void partsJointsMotionsFillColumn(FColDsptr col, const std::function <void(std::shared_ptr<Item>, FColDsptr)>& f);
+		void partsJointsMotionsFillMatrix(SpMatDsptr mat, const std::function <void(std::shared_ptr<Item>, SpMatDsptr)>& f);
 		void logString(std::string& str) override;
 		std::shared_ptr<std::vector<std::shared_ptr<Part>>> parts();
 		//std::shared_ptr<std::vector<ContactEndFrame>> contactEndFrames();
@@ -76,6 +89,12 @@ namespace MbD {
 		double firstOutputTime();
 		double endTime();
 		void settime(double tnew);
+		std::shared_ptr<SymbolicFactorization> symbolicFactorizationFor(Solver* solver);
+		std::shared_ptr<FillReducingOrdering> fillReducingOrderingFor(Solver* solver);
+		std::shared_ptr<BlockTriangularForm> blockTriangularFormFor(Solver* solver);
+		std::shared_ptr<BlockSparseMatrix<double>> jacobianFor(Solver* solver, const std::vector<int>& blockStarts);
+		std::shared_ptr<WorkStealingPool> parallelPool();
+		std::shared_ptr<WorkStealingPool> parallelItemsPool();
 
 		System* system; //Use raw pointer when pointing backwards.
 		std::shared_ptr<Solver> icTypeSolver;
@@ -105,6 +124,31 @@ namespace MbD {
 		int orderMax = 0;
 		double translationLimit = 0.0;
 		double rotationLimit = 0.0;
+		bool reuseSymbolicFactorization = true;
+		std::map<std::string, std::shared_ptr<SymbolicFactorization>> symbolicFactorizations;
+		bool useFillReducingOrdering = true;
+		std::map<std::string, std::shared_ptr<FillReducingOrdering>> fillReducingOrderings;
+		bool useBlockTriangularFormPosIC = false, useBlockTriangularFormPosKine = false;	//Position Newton solves diagonal blocks one after another in block triangular order.
+		std::map<std::string, std::shared_ptr<BlockTriangularForm>> blockTriangularForms;
+		int supernodalSolverThreshold = 1000;	//Newton solves with at least this many equations use GESpMatParPvSupernodal.
+		double jacobianReuseRatioPosIC = 0.0, jacobianReuseRatioPosKine = 0.0;	//Newton keeps its last factors while dxNorm shrinks by this ratio or better. Zero refactors every iteration.
+		bool useBroydenUpdatesAccIC = false, useBroydenUpdatesAccKine = false;	//Acceleration Newton keeps its factors and corrects them by Broyden updates.
+		bool useLineSearchPosIC = false, useLineSearchPosKine = false;	//Backtrack position Newton steps that do not reduce yNorm enough.
+		bool useMovedPartsOnlyPosIC = false, useMovedPartsOnlyPosKine = false;	//Position Newton updates only parts that moved and the joints and motions on them.
+		bool useHomotopyPosIC = true;	//Assembly that does not converge from the input positions is retried by continuation from them.
+		double homotopyFirstIncrementPosIC = 0.125;
+		int homotopyIncrementMaxPosIC = 100;	//Bound on continuation increments, retries included.
+		bool useKrylovSolverPosIC = false, useKrylovSolverPosKine = false, useKrylovSolverVelKine = false, useKrylovSolverAccKine = false;	//Phases solved by GMRESSpMatILU.
+		int nThreads = 1;	//Workers for parallel factorization, connected components and item evaluation. One keeps all work on the calling thread.
+		bool useComponentsAllIC = true;	//runAllIC solves mechanisms not connected to each other by their own SystemSolvers, concurrently with nThreads. Later ICs, as of the kinematic integrator, are of the whole system.
+		bool useRigidClustersPosIC = false;	//Parts held together by fixed joints are first assembled as one body each. Moves the start, and so the result, of the minimum motion position IC.
+		std::shared_ptr<WorkStealingPool> workStealingPool;
+		int parallelItemsMin = 256;	//Position Newton updates and fills parts, joints and motions on nThreads workers when there are at least this many.
+		std::shared_ptr<ParallelItems> parallelItems;
+		std::map<std::string, std::shared_ptr<BlockSparseMatrix<double>>> jacobians;	//Keep their pattern and scatter map across Newton solves.
+		bool usePredictorKine = false;	//Kinematic steps start from the extrapolation of the past converged states.
+		bool reuseKineFactorization = true;
+		std::shared_ptr<MatrixSolver> kineFactorization;	//Last factors of the kinematic position solve, possibly of an earlier Jacobian, for the velocity solve.
 	};
 }
 
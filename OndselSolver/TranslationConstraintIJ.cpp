@@ -20,6 +20,7 @@ void TranslationConstraintIJ::initialize()
 {
     ConstraintIJ::initialize();
     initriIeJeIe();
+    riIeJeIe->owner = this;
 }
 
 void TranslationConstraintIJ::initializeLocally()
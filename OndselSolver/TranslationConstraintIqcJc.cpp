@@ -9,6 +9,7 @@
 #include "TranslationConstraintIqcJc.h"
 #include "DispCompIeqcJecKeqc.h"
 #include "EndFrameqc.h"
+#include "FixedMatrix.h"
 #include "CREATE.h"
 
 using namespace MbD;
@@ -18,6 +19,13 @@ TranslationConstraintIqcJc::TranslationConstraintIqcJc(EndFrmsptr frmi, EndFrmsp
 {
 }
 
+void TranslationConstraintIqcJc::initialize()
+{
+	TranslationConstraintIJ::initialize();
+	pGpEI = std::make_shared<FullRow<double>>(4);
+	ppGpEIpEI = std::make_shared<FullMatrix<double>>(4, 4);
+}
+
 void TranslationConstraintIqcJc::initriIeJeIe()
 {
     riIeJeIe = CREATE<DispCompIeqcJecKeqc>::With(frmI, frmJ, frmI, axisI);
@@ -28,12 +36,18 @@ void TranslationConstraintIqcJc::calcPostDynCorrectorIteration()
 	TranslationConstraintIJ::calcPostDynCorrectorIteration();
 	auto riIeqJeIeq = std::static_pointer_cast<DispCompIeqcJecKeqc>(riIeJeIe);
 	pGpXI = riIeqJeIeq->pvaluepXI();
-	pGpEI = (riIeqJeIeq->pvaluepEI())->plusFullRow(riIeqJeIeq->pvaluepEK());
+	riIeqJeIeq->pvaluepEI()->plusFullRowInto(riIeqJeIeq->pvaluepEK(), pGpEI);
 	ppGpXIpEI = riIeqJeIeq->ppvaluepXIpEK();
-	ppGpEIpEI = riIeqJeIeq->ppvaluepEIpEI()
-            ->plusFullMatrix(riIeqJeIeq->ppvaluepEIpEK())
-            ->plusFullMatrix((riIeqJeIeq->ppvaluepEIpEK()->
-                transpose()->plusFullMatrix(riIeqJeIeq->ppvaluepEKpEK())));
+	auto ppGpEIpEK = Mat4::fromFullMatrix(riIeqJeIeq->ppvaluepEIpEK());
+	auto ppGpEKpEK = Mat4::fromFullMatrix(riIeqJeIeq->ppvaluepEKpEK());
+	auto ppGpEIpEIF = Mat4::fromFullMatrix(riIeqJeIeq->ppvaluepEIpEI());
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			auto& ppGpEIipEIj = ppGpEIpEIF.at(i, j);
+			ppGpEIipEIj = (ppGpEIipEIj + ppGpEIpEK.at(i, j)) + (ppGpEIpEK.at(j, i) + ppGpEKpEK.at(i, j));
+		}
+	}
+	ppGpEIpEIF.copyInto(ppGpEIpEI);
 }
 
 void TranslationConstraintIqcJc::useEquationNumbers()
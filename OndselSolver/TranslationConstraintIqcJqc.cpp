@@ -18,6 +18,13 @@ TranslationConstraintIqcJqc::TranslationConstraintIqcJqc(EndFrmsptr frmi, EndFrm
 {
 }
 
+void TranslationConstraintIqcJqc::initialize()
+{
+	TranslationConstraintIqcJc::initialize();
+	ppGpEIpXJ = std::make_shared<FullMatrix<double>>(4, 3);
+	ppGpEIpEJ = std::make_shared<FullMatrix<double>>(4, 4);
+}
+
 void TranslationConstraintIqcJqc::initriIeJeIe()
 {
 	riIeJeIe = CREATE<DispCompIeqcJeqcKeqc>::With(frmI, frmJ, frmI, axisI);
@@ -28,8 +35,8 @@ void TranslationConstraintIqcJqc::calcPostDynCorrectorIteration()
 	TranslationConstraintIqcJc::calcPostDynCorrectorIteration();
 	pGpXJ = riIeJeIe->pvaluepXJ();
 	pGpEJ = riIeJeIe->pvaluepEJ();
-	ppGpEIpXJ = riIeJeIe->ppvaluepXJpEK()->transpose();
-	ppGpEIpEJ = riIeJeIe->ppvaluepEJpEK()->transpose();
+	riIeJeIe->ppvaluepXJpEK()->transposeInto(ppGpEIpXJ);
+	riIeJeIe->ppvaluepEJpEK()->transposeInto(ppGpEIpEJ);
 	ppGpEJpEJ = riIeJeIe->ppvaluepEJpEJ();
 }
 
@@ -18,6 +18,7 @@ namespace MbD {
         TranslationConstraintIqcJqc(EndFrmsptr frmi, EndFrmsptr frmj, int axisi);
 
         void calcPostDynCorrectorIteration() override;
+        void initialize() override;
         void initriIeJeIe() override;
         void fillAccICIterError(FColDsptr col) override;
         void fillPosICError(FColDsptr col) override;
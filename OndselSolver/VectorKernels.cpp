@@ -0,0 +1,321 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include "VectorKernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define MBD_VECTORKERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define MBD_TARGET(isa)
+#else
+#define MBD_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+using namespace MbD;
+
+namespace {
+	struct Kernels {
+		double (*dot)(const double*, const double*, int);
+		double (*sumOfSquares)(const double*, int);
+		double (*maxMagnitude)(const double*, int);
+		void (*plusTimes)(double*, const double*, double, int);
+		void (*times)(double*, double, int);
+	};
+
+	double scalarDot(const double* a, const double* b, int n)
+	{
+		double answer = 0.0;
+		for (int i = 0; i < n; i++) answer += a[i] * b[i];
+		return answer;
+	}
+	double scalarSumOfSquares(const double* a, int n)
+	{
+		double sum = 0.0;
+		for (int i = 0; i < n; i++) sum += a[i] * a[i];
+		return sum;
+	}
+	double scalarMaxMagnitude(const double* a, int n)
+	{
+		double max = 0.0;
+		for (int i = 0; i < n; i++)
+		{
+			double element = a[i];
+			if (element < 0.0) element = -element;
+			if (max < element) max = element;
+		}
+		return max;
+	}
+	void scalarPlusTimes(double* y, const double* x, double factor, int n)
+	{
+		for (int i = 0; i < n; i++) y[i] += x[i] * factor;
+	}
+	void scalarTimes(double* y, double factor, int n)
+	{
+		for (int i = 0; i < n; i++) y[i] *= factor;
+	}
+	const Kernels scalarKernels = { scalarDot, scalarSumOfSquares, scalarMaxMagnitude, scalarPlusTimes, scalarTimes };
+
+#ifdef MBD_VECTORKERNELS_X86
+	//"max_pd(x, max) answers max when x is NaN, which the scalar comparison also ignores."
+	MBD_TARGET("avx2,fma") double horizontalSum(__m256d v)
+	{
+		auto pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+		return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+	}
+	MBD_TARGET("avx2,fma") double horizontalMax(__m256d v)
+	{
+		auto pair = _mm_max_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+		return _mm_cvtsd_f64(_mm_max_sd(pair, _mm_unpackhi_pd(pair, pair)));
+	}
+	MBD_TARGET("avx2,fma") double avx2Dot(const double* a, const double* b, int n)
+	{
+		auto sum0 = _mm256_setzero_pd();
+		auto sum1 = _mm256_setzero_pd();
+		int i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), sum0);
+			sum1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), sum1);
+		}
+		auto answer = horizontalSum(_mm256_add_pd(sum0, sum1));
+		for (; i < n; i++) answer += a[i] * b[i];
+		return answer;
+	}
+	MBD_TARGET("avx2,fma") double avx2SumOfSquares(const double* a, int n)
+	{
+		auto sum0 = _mm256_setzero_pd();
+		auto sum1 = _mm256_setzero_pd();
+		int i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			auto a0 = _mm256_loadu_pd(a + i);
+			auto a1 = _mm256_loadu_pd(a + i + 4);
+			sum0 = _mm256_fmadd_pd(a0, a0, sum0);
+			sum1 = _mm256_fmadd_pd(a1, a1, sum1);
+		}
+		auto sum = horizontalSum(_mm256_add_pd(sum0, sum1));
+		for (; i < n; i++) sum += a[i] * a[i];
+		return sum;
+	}
+	MBD_TARGET("avx2,fma") double avx2MaxMagnitude(const double* a, int n)
+	{
+		auto signMask = _mm256_set1_pd(-0.0);
+		auto max0 = _mm256_setzero_pd();
+		auto max1 = _mm256_setzero_pd();
+		int i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			max0 = _mm256_max_pd(_mm256_andnot_pd(signMask, _mm256_loadu_pd(a + i)), max0);
+			max1 = _mm256_max_pd(_mm256_andnot_pd(signMask, _mm256_loadu_pd(a + i + 4)), max1);
+		}
+		auto max = horizontalMax(_mm256_max_pd(max0, max1));
+		for (; i < n; i++)
+		{
+			double element = a[i];
+			if (element < 0.0) element = -element;
+			if (max < element) max = element;
+		}
+		return max;
+	}
+	MBD_TARGET("avx2,fma") void avx2PlusTimes(double* y, const double* x, double factor, int n)
+	{
+		//"Multiply then add as the scalar loop does. A fused multiply add would round differently."
+		auto f = _mm256_set1_pd(factor);
+		int i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			_mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_loadu_pd(y + i), _mm256_mul_pd(_mm256_loadu_pd(x + i), f)));
+		}
+		for (; i < n; i++) y[i] += x[i] * factor;
+	}
+	MBD_TARGET("avx2,fma") void avx2Times(double* y, double factor, int n)
+	{
+		auto f = _mm256_set1_pd(factor);
+		int i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			_mm256_storeu_pd(y + i, _mm256_mul_pd(_mm256_loadu_pd(y + i), f));
+		}
+		for (; i < n; i++) y[i] *= factor;
+	}
+	const Kernels avx2Kernels = { avx2Dot, avx2SumOfSquares, avx2MaxMagnitude, avx2PlusTimes, avx2Times };
+
+	MBD_TARGET("avx512f") double avx512Dot(const double* a, const double* b, int n)
+	{
+		auto sum0 = _mm512_setzero_pd();
+		auto sum1 = _mm512_setzero_pd();
+		int i = 0;
+		for (; i + 16 <= n; i += 16)
+		{
+			sum0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), sum0);
+			sum1 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 8), _mm512_loadu_pd(b + i + 8), sum1);
+		}
+		if (i < n) {
+			auto mask = (__mmask8)((1u << std::min(n - i, 8)) - 1);
+			sum0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, a + i), _mm512_maskz_loadu_pd(mask, b + i), sum0);
+			i += 8;
+			if (i < n) {
+				mask = (__mmask8)((1u << (n - i)) - 1);
+				sum1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, a + i), _mm512_maskz_loadu_pd(mask, b + i), sum1);
+			}
+		}
+		return _mm512_reduce_add_pd(_mm512_add_pd(sum0, sum1));
+	}
+	MBD_TARGET("avx512f") double avx512SumOfSquares(const double* a, int n)
+	{
+		auto sum0 = _mm512_setzero_pd();
+		auto sum1 = _mm512_setzero_pd();
+		int i = 0;
+		for (; i + 16 <= n; i += 16)
+		{
+			auto a0 = _mm512_loadu_pd(a + i);
+			auto a1 = _mm512_loadu_pd(a + i + 8);
+			sum0 = _mm512_fmadd_pd(a0, a0, sum0);
+			sum1 = _mm512_fmadd_pd(a1, a1, sum1);
+		}
+		for (; i < n; i += 8)
+		{
+			auto mask = (__mmask8)((1u << std::min(n - i, 8)) - 1);
+			auto a0 = _mm512_maskz_loadu_pd(mask, a + i);
+			sum0 = _mm512_fmadd_pd(a0, a0, sum0);
+		}
+		return _mm512_reduce_add_pd(_mm512_add_pd(sum0, sum1));
+	}
+	MBD_TARGET("avx512f") double avx512MaxMagnitude(const double* a, int n)
+	{
+		auto max0 = _mm512_setzero_pd();
+		int i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			max0 = _mm512_max_pd(_mm512_abs_pd(_mm512_loadu_pd(a + i)), max0);
+		}
+		if (i < n) {
+			auto mask = (__mmask8)((1u << (n - i)) - 1);
+			max0 = _mm512_max_pd(_mm512_abs_pd(_mm512_maskz_loadu_pd(mask, a + i)), max0);
+		}
+		return _mm512_reduce_max_pd(max0);
+	}
+	MBD_TARGET("avx512f") void avx512PlusTimes(double* y, const double* x, double factor, int n)
+	{
+		auto f = _mm512_set1_pd(factor);
+		int i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			_mm512_storeu_pd(y + i, _mm512_add_pd(_mm512_loadu_pd(y + i), _mm512_mul_pd(_mm512_loadu_pd(x + i), f)));
+		}
+		if (i < n) {
+			auto mask = (__mmask8)((1u << (n - i)) - 1);
+			auto sum = _mm512_add_pd(_mm512_maskz_loadu_pd(mask, y + i), _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, x + i), f));
+			_mm512_mask_storeu_pd(y + i, mask, sum);
+		}
+	}
+	MBD_TARGET("avx512f") void avx512Times(double* y, double factor, int n)
+	{
+		auto f = _mm512_set1_pd(factor);
+		int i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			_mm512_storeu_pd(y + i, _mm512_mul_pd(_mm512_loadu_pd(y + i), f));
+		}
+		if (i < n) {
+			auto mask = (__mmask8)((1u << (n - i)) - 1);
+			_mm512_mask_storeu_pd(y + i, mask, _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, y + i), f));
+		}
+	}
+	const Kernels avx512Kernels = { avx512Dot, avx512SumOfSquares, avx512MaxMagnitude, avx512PlusTimes, avx512Times };
+
+	VectorKernels::InstructionSet detectInstructionSet()
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		//"Leaf 7 ebx bit 5 is AVX2 and bit 16 AVX-512F. Leaf 1 ecx bit 12 is FMA and bit 27 OSXSAVE."
+		//"xgetbv tells whether the operating system saves the ymm and zmm registers."
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7) return VectorKernels::InstructionSet::scalar;
+		__cpuid(info, 1);
+		bool hasFma = (info[2] & (1 << 12)) != 0;
+		bool hasOsxsave = (info[2] & (1 << 27)) != 0;
+		if (!hasOsxsave) return VectorKernels::InstructionSet::scalar;
+		auto xcr0 = _xgetbv(0);
+		__cpuidex(info, 7, 0);
+		bool hasAvx2 = hasFma && (info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6;
+		bool hasAvx512 = (info[1] & (1 << 16)) != 0 && (xcr0 & 0xe6) == 0xe6;
+		if (hasAvx512) return VectorKernels::InstructionSet::avx512;
+		if (hasAvx2) return VectorKernels::InstructionSet::avx2;
+		return VectorKernels::InstructionSet::scalar;
+#else
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx512f")) return VectorKernels::InstructionSet::avx512;
+		if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return VectorKernels::InstructionSet::avx2;
+		return VectorKernels::InstructionSet::scalar;
+#endif
+	}
+#else
+	VectorKernels::InstructionSet detectInstructionSet()
+	{
+		return VectorKernels::InstructionSet::scalar;
+	}
+#endif
+
+	const Kernels* kernelsFor(VectorKernels::InstructionSet set)
+	{
+#ifdef MBD_VECTORKERNELS_X86
+		if (set == VectorKernels::InstructionSet::avx512) return &avx512Kernels;
+		if (set == VectorKernels::InstructionSet::avx2) return &avx2Kernels;
+#endif
+		return &scalarKernels;
+	}
+
+	const VectorKernels::InstructionSet currentSet = detectInstructionSet();
+	const Kernels* const current = kernelsFor(currentSet);
+}
+
+VectorKernels::InstructionSet VectorKernels::instructionSet()
+{
+	return currentSet;
+}
+
+const char* VectorKernels::nameOf(InstructionSet set)
+{
+	switch (set) {
+	case InstructionSet::avx512: return "avx512";
+	case InstructionSet::avx2: return "avx2";
+	default: return "scalar";
+	}
+}
+
+double VectorKernels::dot(const double* a, const double* b, int n)
+{
+	return current->dot(a, b, n);
+}
+
+double VectorKernels::sumOfSquares(const double* a, int n)
+{
+	return current->sumOfSquares(a, n);
+}
+
+double VectorKernels::maxMagnitude(const double* a, int n)
+{
+	return current->maxMagnitude(a, n);
+}
+
+void VectorKernels::plusTimes(double* y, const double* x, double factor, int n)
+{
+	current->plusTimes(y, x, factor, n);
+}
+
+void VectorKernels::times(double* y, double factor, int n)
+{
+	current->times(y, factor, n);
+}
@@ -0,0 +1,31 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+
+#pragma once
+
+namespace MbD {
+    class VectorKernels
+    {
+        //"Loops over contiguous double arrays with the instruction set chosen once at run time."
+        //"AVX-512 or AVX2 with FMA on x86 processors that have them. Plain loops everywhere else."
+        //"Reductions keep several partial sums, so results differ from a sequential loop in the last bits."
+        //"The call is indirect. Callers keep their own loops below minimumLength."
+    public:
+        enum class InstructionSet { scalar, avx2, avx512 };
+        static constexpr int minimumLength = 16;
+
+        static InstructionSet instructionSet();
+        static const char* nameOf(InstructionSet set);
+
+        static double dot(const double* a, const double* b, int n);
+        static double sumOfSquares(const double* a, int n);
+        static double maxMagnitude(const double* a, int n);
+        static void plusTimes(double* y, const double* x, double factor, int n);
+        static void times(double* y, double factor, int n);
+    };
+}
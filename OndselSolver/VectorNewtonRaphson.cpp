@@ -30,6 +30,8 @@ void VectorNewtonRaphson::run()
 	this->initializeLocally();
 	this->initializeGlobally();
 	this->iterate();
+	matrixSolver->releaseScratch();
+	this->reportStats();
 	this->postRun();
 }
 
@@ -50,6 +52,9 @@ void VectorNewtonRaphson::calcyNorm()
 
 void VectorNewtonRaphson::solveEquations()
 {
+	//"Scratch of the previous solve is dead by now."
+	matrixSolver->releaseScratch();
+	iterationArena.reset();
 	try {
 		this->basicSolveEquations();
 	}
@@ -70,6 +75,7 @@ void VectorNewtonRaphson::calcdxNorm()
 
 bool VectorNewtonRaphson::isConverged()
 {
+	if (iterNo != iterNoOfJacobian && !this->usesBroydenUpdates()) return false;
 	return dxNorms->at(iterNo) < dxTol || isConvergedToNumericalLimit();
 }
 
@@ -78,6 +84,17 @@ void VectorNewtonRaphson::xEqualxoldPlusdx()
 	x = xold->plusFullColumn(dx);
 }
 
+bool VectorNewtonRaphson::hasReusableJacobian()
+{
+	return matrixSolver != nullptr && matrixSolver->hasReusableFactors();
+}
+
+void VectorNewtonRaphson::xEqualxoldPluslamdx()
+{
+	x = xold->copy();
+	x->equalSelfPlusFullColumntimes(dx, lam);
+}
+
 void VectorNewtonRaphson::handleSingularMatrix()
 {
 	assert(false);
@@ -10,11 +10,12 @@
 
 #include "NewtonRaphson.h"
 #include "MatrixSolver.h"
+#include "MemoryArena.h"
 
 namespace MbD {
     class VectorNewtonRaphson : public NewtonRaphson
     {
-        //matrixSolver n
+        //iterationArena matrixSolver n
     public:
         void initializeGlobally() override;
         void run() override;
@@ -26,9 +27,12 @@ namespace MbD {
         void calcdxNorm() override;
         bool isConverged() override;
         void xEqualxoldPlusdx() override;
+        void xEqualxoldPluslamdx() override;
         virtual void basicSolveEquations() = 0;
         virtual void handleSingularMatrix() override;
+        bool hasReusableJacobian() override;
 
+        MemoryArena iterationArena;	//Scratch of the matrix solve. Declared before matrixSolver so it is destroyed after it.
         std::shared_ptr<MatrixSolver> matrixSolver;
         int n = -1;
         FColDsptr xold, x, dx, y;
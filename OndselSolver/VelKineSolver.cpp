@@ -11,6 +11,9 @@
 #include "SystemSolver.h"
 #include "Part.h"
 #include "Constraint.h"
+#include "CREATE.h"
+#include "GMRESSpMatILU.h"
+#include "MatrixSolver.h"
 
 using namespace MbD;
 
@@ -54,14 +57,41 @@ void VelKineSolver::run()
 	this->assignEquationNumbers();
 	system->partsJointsMotionsDo([](std::shared_ptr<Item> item) { item->useEquationNumbers(); });
 	errorVector = std::make_shared<FullColumn<double>>(n);
-	jacobian = std::make_shared<SparseMatrix<double>>(n, n);
 	errorVector->zeroSelf();
 	system->partsJointsMotionsDo([&](std::shared_ptr<Item> item) { item->fillVelICError(errorVector); });
+	jacobian = std::make_shared<SparseMatrix<double>>(n, n);
 	jacobian->zeroSelf();
 	system->partsJointsMotionsDo([&](std::shared_ptr<Item> item) { item->fillPosKineJacob(jacobian); });
-	matrixSolver = this->matrixSolverClassNew();
-	this->solveEquations();
+	if (!this->solveWithKineFactorization()) {
+		matrixSolver = this->matrixSolverClassNew();
+		this->solveEquations();
+	}
 	auto& qsudot = this->x;
 	system->partsJointsMotionsDo([&](std::shared_ptr<Item> item) { item->setqsudot(qsudot); });
 	system->partsJointsMotionsDo([](std::shared_ptr<Item> item) { item->postVelIC(); });
 }
+
+bool VelKineSolver::solveWithKineFactorization()
+{
+	//"The factors are those position Newton last solved with. Reuse within and across steps makes them"
+	//"factors of an earlier Jacobian, possibly of an earlier step. Refinement against the converged Jacobian"
+	//"makes up the difference. Without refinement convergence the velocities are solved with new factors."
+	auto factorization = system->kineFactorization;
+	if (factorization == nullptr || system->useKrylovSolverVelKine) return false;
+	if (!factorization->hasReusableFactorsOfOrder(n)) return false;
+	auto tol = refinementTolerance * errorVector->maxMagnitude();
+	x = factorization->solveWithFactors(errorVector);
+	for (int i = 0; i < iterMaxRefinement; i++)
+	{
+		auto residual = errorVector->minusFullColumn(jacobian->timesFullColumn(x));
+		if (residual->maxMagnitude() <= tol) return true;
+		x->equalSelfPlusFullColumntimes(factorization->solveWithFactors(residual), 1.0);
+	}
+	return false;
+}
+
+std::shared_ptr<MatrixSolver> VelKineSolver::matrixSolverClassNew()
+{
+	if (system->useKrylovSolverVelKine) return CREATE<GMRESSpMatILU>::With();
+	return VelSolver::matrixSolverClassNew();
+}
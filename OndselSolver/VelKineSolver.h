@@ -17,7 +17,11 @@ namespace MbD {
     public:
         void assignEquationNumbers() override;
         void run() override;
+        std::shared_ptr<MatrixSolver> matrixSolverClassNew() override;
+        bool solveWithKineFactorization();
 
+        int iterMaxRefinement = 4;
+        double refinementTolerance = 1.0e-12;	//Relative to the largest velocity equation error.
     };
 }
 
@@ -24,21 +24,13 @@ void VelSolver::basicSolveEquations()
 
 void VelSolver::handleSingularMatrix()
 {
-    auto& r = *matrixSolver;
-	std::string str = typeid(r).name();
-	if (str.find("GESpMatParPvMarkoFast") != std::string::npos) {
+	if (!matrixSolver->isPrecise()) {
 		matrixSolver = CREATE<GESpMatParPvPrecise>::With();
 		this->solveEquations();
 	}
 	else {
-		str = typeid(r).name();
-		if (str.find("GESpMatParPvPrecise") != std::string::npos) {
-			this->logSingularMatrixMessage();
-			matrixSolver = this->matrixSolverClassNew();
-		}
-		else {
-			assert(false);
-		}
+		this->logSingularMatrixMessage();
+		matrixSolver = this->matrixSolverClassNew();
 	}
 }
 
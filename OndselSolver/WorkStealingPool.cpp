@@ -0,0 +1,122 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+ 
+#include <cassert>
+
+#include "WorkStealingPool.h"
+
+using namespace MbD;
+
+WorkStealingPool::WorkStealingPool(int n) : nWorker(n < 1 ? 1 : n), queues(nWorker)
+{
+	for (int i = 0; i < nWorker; i++)
+	{
+		mutexes.push_back(std::make_unique<std::mutex>());
+	}
+	for (int i = 1; i < nWorker; i++)
+	{
+		threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+	}
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(idleMutex);
+		isShuttingDown = true;
+	}
+	idleCondition.notify_all();
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+int WorkStealingPool::numberOfWorkers()
+{
+	return nWorker;
+}
+
+void WorkStealingPool::submit(int worker, Task task)
+{
+	//"Tasks may submit further tasks. They go to the queue of the submitting worker."
+	nPending++;
+	{
+		std::lock_guard<std::mutex> lock(*mutexes[worker]);
+		queues[worker].push_back(std::move(task));
+		nQueued++;
+	}
+	if (nWorker > 1) {
+		std::lock_guard<std::mutex> lock(idleMutex);
+		idleCondition.notify_one();
+	}
+}
+
+void WorkStealingPool::wait()
+{
+	//"Run tasks as worker 0 until every submitted task has finished. Sleep while the others run the last ones."
+	while (nPending > 0) {
+		if (this->runOneTask(0)) continue;
+		std::unique_lock<std::mutex> lock(idleMutex);
+		idleCondition.wait(lock, [&]() { return nPending == 0 || nQueued > 0; });
+	}
+	std::exception_ptr firstError;
+	{
+		std::lock_guard<std::mutex> lock(idleMutex);
+		std::swap(firstError, error);
+	}
+	if (firstError) std::rethrow_exception(firstError);
+}
+
+bool WorkStealingPool::runOneTask(int worker)
+{
+	Task task;
+	{
+		std::lock_guard<std::mutex> lock(*mutexes[worker]);
+		auto& queue = queues[worker];
+		if (!queue.empty()) {
+			task = std::move(queue.back());
+			queue.pop_back();
+			nQueued--;
+		}
+	}
+	for (int i = 1; !task && i < nWorker; i++)
+	{
+		auto victim = (worker + i) % nWorker;
+		std::lock_guard<std::mutex> lock(*mutexes[victim]);
+		auto& queue = queues[victim];
+		if (!queue.empty()) {
+			task = std::move(queue.front());
+			queue.pop_front();
+			nQueued--;
+		}
+	}
+	if (!task) return false;
+	try {
+		task(worker);
+	}
+	catch (...) {
+		std::lock_guard<std::mutex> lock(idleMutex);
+		if (!error) error = std::current_exception();
+	}
+	if (--nPending == 0) {
+		std::lock_guard<std::mutex> lock(idleMutex);
+		idleCondition.notify_all();
+	}
+	return true;
+}
+
+void WorkStealingPool::workerLoop(int worker)
+{
+	while (true) {
+		if (this->runOneTask(worker)) continue;
+		std::unique_lock<std::mutex> lock(idleMutex);
+		idleCondition.wait(lock, [&]() { return isShuttingDown || nQueued > 0; });
+		if (isShuttingDown) return;
+	}
+}
@@ -0,0 +1,54 @@
+/***************************************************************************
+ *   Copyright (c) 2023 Ondsel, Inc.                                       *
+ *                                                                         *
+ *   This file is part of OndselSolver.                                    *
+ *                                                                         *
+ *   See LICENSE file for details about copyright.                         *
+ ***************************************************************************/
+ 
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <exception>
+
+namespace MbD {
+    class WorkStealingPool
+    {
+        //nWorker queues mutexes threads nPending nQueued isShuttingDown error 
+        //"Persistent workers, each with its own task queue."
+        //"A worker takes from the back of its own queue and steals from the front of the others."
+        //"The calling thread is worker 0 and works inside wait, so one worker runs everything inline."
+        //"Workers sleep while no task is queued. The first exception of a task is rethrown by wait."
+    public:
+        using Task = std::function<void(int worker)>;
+
+        WorkStealingPool(int nWorker);
+        ~WorkStealingPool();
+        int numberOfWorkers();
+        void submit(int worker, Task task);
+        void wait();
+
+    private:
+        bool runOneTask(int worker);
+        void workerLoop(int worker);
+
+        int nWorker;
+        std::vector<std::deque<Task>> queues;
+        std::vector<std::unique_ptr<std::mutex>> mutexes;
+        std::vector<std::thread> threads;
+        std::mutex idleMutex;
+        std::condition_variable idleCondition;
+        std::atomic<int> nPending{ 0 };   //Submitted and not finished.
+        std::atomic<int> nQueued{ 0 };    //Submitted and not taken by a worker.
+        bool isShuttingDown = false;
+        std::exception_ptr error;
+    };
+}
+
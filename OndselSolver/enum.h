@@ -11,4 +11,5 @@ namespace MbD {
 	enum ConstraintType { essential, displacement, perpendicular, redundant };
 	enum DiscontinuityType { TOUCHDOWN, REBOUND, LIFTOFF };
 	enum AnalysisType { INPUT, INITIALCONDITION, DYNAMIC, STATIC };
+	enum DerivativeDemand { FIRSTDERIVATIVES, LAMWEIGHTEDSECONDDERIVATIVES, SECONDDERIVATIVES };
 }
\ No newline at end of file